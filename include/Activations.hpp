@@ -0,0 +1,32 @@
+/*
+ */
+#pragma once
+#include <NeuralNetwork.hpp>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Array forms of the activation functions and their derivatives. Exact uses the standard library,
+	 * HighAccuracy a double precision polynomial exp (within a few ulp) and Fast a single precision one (relative
+	 * error around 1e-5). The loops are branch free so they vectorize. differentiate takes output values,
+	 * matching NeuralNetwork::derivative.
+	 *
+	 * NeuralNetwork::derivative evaluates the Tanh and Swish formulas at the output value, so Tanh's is
+	 * 1 - tanh(y)^2 rather than 1 - y^2, and the approximations keep that on purpose: they have to approximate the
+	 * Exact mode, whose training results must not change, so switching accuracy never changes what is learned.
+	 * The second tanh or exp therefore stays, it is the cheap vectorized one.
+	 */
+	struct Activations
+	{
+		static void activate(const NeuralNetwork::ActivationType &activationType, const NeuralNetwork::ActivationAccuracy &accuracy, double *values, const unsigned long &size);
+		static void differentiate(const NeuralNetwork::ActivationType &activationType, const NeuralNetwork::ActivationAccuracy &accuracy, double *values, const unsigned long &size);
+		template <typename T>
+		static void softmax(const NeuralNetwork::ActivationAccuracy &accuracy, T *values, const unsigned long &size);
+		static const double exp(const double &x, const NeuralNetwork::ActivationAccuracy &accuracy);
+		static const double tanh(const double &x, const NeuralNetwork::ActivationAccuracy &accuracy);
+		static const double sigmoid(const double &x, const NeuralNetwork::ActivationAccuracy &accuracy);
+	};
+}
+/*
+ */
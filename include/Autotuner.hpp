@@ -0,0 +1,45 @@
+/*
+ */
+#pragma once
+#include <NeuralNetwork.hpp>
+#include <map>
+#include <string>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Picks the kernel plan (serial or split across the executor, and the backward column block size) of every
+	 * dense layer by timing the candidates on the network itself, whose parameters are restored afterwards. Plans
+	 * are cached per CPU model, layer shape, executor size and weight precision in a text file, so only
+	 * configurations this host has not seen are timed.
+	 * The plan never changes the results, every candidate computes each value in the same order.
+	 */
+	struct Autotuner
+	{
+		struct Plan
+		{
+			Layer::Schedule schedule = Layer::Automatic;
+			unsigned long backwardBlockSize = 0;
+			// Fastest feedforward and backpropagate pass measured with this plan
+			long double seconds = 0;
+		};
+		std::string cachePath;
+		std::string cpuModel;
+		std::vector<unsigned long> blockSizes = {32, 64, 128, 256, 512, 1024};
+		unsigned long repetitions = 5;
+		// Cached plans of every CPU model, keyed by model, shape, workers and precision
+		std::map<std::string, Plan> plans;
+		Autotuner(const std::string &cachePath = "zeuron.tuning");
+		const std::vector<Plan> tune(NeuralNetwork &network);
+		const bool find(const unsigned long &inputsSize, const unsigned long &neuronsSize, const unsigned long &workers, const Precision::Type &precision, Plan &plan) const;
+		void load();
+		void save() const;
+		static const std::string readCpuModel();
+	private:
+		const std::string key(const unsigned long &inputsSize, const unsigned long &neuronsSize, const unsigned long &workers, const Precision::Type &precision) const;
+		const long double measure(NeuralNetwork &network, const std::vector<long double> &inputValues, const std::vector<long double> &targetValues);
+	};
+}
+/*
+ */
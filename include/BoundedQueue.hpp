@@ -0,0 +1,80 @@
+/*
+ */
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Blocking FIFO with a fixed capacity. push blocks while the queue is full and pop while it is empty; once
+	 * closed, push fails and pop drains the remaining items before failing.
+	 */
+	template <typename T>
+	struct BoundedQueue
+	{
+		std::mutex mutex;
+		std::condition_variable notEmpty;
+		std::condition_variable notFull;
+		std::deque<T> items;
+		unsigned long capacity;
+		bool closed = false;
+		BoundedQueue(const unsigned long &capacity):
+			capacity(capacity ? capacity : 1)
+		{};
+		const bool push(T item)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			notFull.wait(lock, [this] { return closed || items.size() < capacity; });
+			if (closed)
+			{
+				return false;
+			}
+			items.push_back(std::move(item));
+			lock.unlock();
+			notEmpty.notify_one();
+			return true;
+		};
+		// Fails instead of blocking when the queue is full
+		const bool tryPush(T item)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (closed || items.size() >= capacity)
+				{
+					return false;
+				}
+				items.push_back(std::move(item));
+			}
+			notEmpty.notify_one();
+			return true;
+		};
+		const bool pop(T &item)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			notEmpty.wait(lock, [this] { return closed || !items.empty(); });
+			if (items.empty())
+			{
+				return false;
+			}
+			item = std::move(items.front());
+			items.pop_front();
+			lock.unlock();
+			notFull.notify_one();
+			return true;
+		};
+		void close()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				closed = true;
+			}
+			notEmpty.notify_all();
+			notFull.notify_all();
+		};
+	};
+}
+/*
+ */
@@ -0,0 +1,28 @@
+/*
+ */
+#pragma once
+#include <NeuralNetwork.hpp>
+#include <string>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Emits a trained network as a self-contained C++ header: the weights and biases become constexpr arrays and
+	 * inference is a fully unrolled inline function specialized to the topology and activation. The header only
+	 * depends on <cmath>.
+	 *
+	 * Reduced precision networks are emitted with the weights they serve (their half or bfloat16 values), not
+	 * their master weights, but the header accumulates in long double where the network accumulates in float.
+	 * The header always uses the exact activation functions, whatever the network's activation accuracy. Both
+	 * cases are noted in the generated header's comment.
+	 */
+	struct CodeGenerator
+	{
+		static const std::string generateHeader(const NeuralNetwork &network, const std::string &name);
+		static void writeHeader(const NeuralNetwork &network, const std::string &name, const std::string &filename);
+		static void writeHeader(const std::string &modelFilename, const std::string &name, const std::string &filename);
+	};
+}
+/*
+ */
@@ -0,0 +1,20 @@
+/*
+ */
+#pragma once
+#include <vector>
+/*
+ */
+namespace nnpp
+{
+	struct Dataset
+	{
+		std::vector<std::vector<long double>> inputs;
+		std::vector<std::vector<long double>> outputs;
+		const unsigned long size() const
+		{
+			return inputs.size();
+		};
+	};
+}
+/*
+ */
@@ -0,0 +1,45 @@
+/*
+ */
+#pragma once
+#include <NeuralNetwork.hpp>
+#include <Dataset.hpp>
+#include <memory>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Compresses a trained teacher into a smaller student: the teacher labels a dataset (its own inputs, synthetic
+	 * ones or both) with soft targets and the student, built with the teacher's activation and output mode, is
+	 * trained on them. For softmax teachers a temperature above 1 flattens the targets so the student also learns
+	 * how the teacher ranks the wrong classes. The student is trained at that temperature and served at 1, like
+	 * the teacher.
+	 */
+	struct DistillationTrainer
+	{
+		struct Report
+		{
+			// Mean squared difference between student and teacher outputs, both at temperature 1
+			long double meanSquaredError = 0;
+			// Fraction of samples where the student picks the teacher's class (the largest output, or the side of
+			// 0.5 for a single output)
+			long double agreement = 0;
+			unsigned long teacherParameters = 0;
+			unsigned long studentParameters = 0;
+		};
+		NeuralNetwork &teacher;
+		Executor *executor = 0;
+		long double temperature = 1;
+		long double learningRate = 0.13;
+		unsigned long epochs = 1000;
+		DistillationTrainer(NeuralNetwork &teacher);
+		const Dataset softTargets(const std::vector<std::vector<long double>> &inputs);
+		static const std::vector<std::vector<long double>> syntheticInputs(const Dataset &reference, const unsigned long &count);
+		std::shared_ptr<NeuralNetwork> distill(const std::vector<unsigned long> &studentLayerSizes, const Dataset &transferSet);
+		const Report evaluate(NeuralNetwork &student, const std::vector<std::vector<long double>> &inputs);
+	private:
+		const std::vector<std::vector<long double>> predictAll(NeuralNetwork &network, const std::vector<std::vector<long double>> &inputs);
+	};
+}
+/*
+ */
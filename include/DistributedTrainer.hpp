@@ -0,0 +1,37 @@
+/*
+ */
+#pragma once
+#include <NeuralNetwork.hpp>
+#include <ParameterTransport.hpp>
+#include <Dataset.hpp>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Data-parallel training across processes, each owning a replica of the network. The constructor broadcasts
+	 * rank 0's model through its serialized form. Every global batch is split between the ranks by sample index.
+	 * GradientAllReduce accumulates every sample's gradient at the batch's starting parameters without applying
+	 * it, sums the accumulations over the ranks and takes one step on the mean gradient of the global batch, which
+	 * is synchronous mini-batch SGD. ModelAveraging trains the replicas independently and
+	 * averages their parameters every averagingInterval batches and at the end of each train call.
+	 */
+	struct DistributedTrainer
+	{
+		enum Mode
+		{
+			GradientAllReduce,
+			ModelAveraging
+		};
+		NeuralNetwork &network;
+		ParameterTransport &transport;
+		Mode mode;
+		unsigned long averagingInterval;
+		DistributedTrainer(NeuralNetwork &network, ParameterTransport &transport, const Mode &mode = GradientAllReduce, const unsigned long &averagingInterval = 16);
+		void broadcastModel();
+		void synchronize();
+		const long double train(const Dataset &dataset, const unsigned long &batchSize);
+	};
+}
+/*
+ */
@@ -0,0 +1,112 @@
+/*
+ */
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Fixed pool of worker threads owned by the library. Every worker has its own deque per priority: tasks
+	 * submitted from a worker go to the back of its deque and are popped from the back (LIFO), tasks submitted
+	 * from other threads are spread round robin, and idle workers steal from the front of the other deques. High
+	 * priority tasks (inference) are taken before any Normal one (training). Tasks submitted without a priority
+	 * from inside a task inherit that task's priority.
+	 *
+	 * Constructed from a HostPool the executor owns no threads and posts one runner per task to the host
+	 * application's pool instead. All other executors share the process-wide core budget: the active workers of
+	 * all of them never exceed it, the rest are parked, and an executor left without an active worker runs
+	 * submitted tasks on the submitting thread. Threads the library runs outside any executor hold a
+	 * CoreReservation while they work, which the budget serves before every executor.
+	 *
+	 * An exception escaping a submitted task does not stop the worker: the first one is kept until
+	 * takeTaskException collects it and later ones are dropped. Tasks that signal completion through a counter
+	 * must still do so when they fail, or their waiters never wake.
+	 */
+	struct Executor
+	{
+		typedef std::function<void()> Task;
+		enum Priority
+		{
+			High,
+			Normal,
+			Inherit
+		};
+		static const unsigned long prioritiesCount = 2;
+		/*
+		 * Thread pool of the host application. post must eventually run every runner it is given, the executor's
+		 * destructor waits for them
+		 */
+		struct HostPool
+		{
+			virtual ~HostPool() = default;
+			virtual void post(Task runner) = 0;
+			virtual const unsigned long concurrency() const = 0;
+		};
+		/*
+		 * Counts cores used by threads outside the executors against the core budget until destruction. The
+		 * reservation always succeeds, the executors park workers to make room for it
+		 */
+		struct CoreReservation
+		{
+			unsigned long cores;
+			CoreReservation(const unsigned long &cores = 1);
+			CoreReservation(const CoreReservation &) = delete;
+			~CoreReservation();
+		};
+		struct WorkerQueue
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks[prioritiesCount];
+		};
+		std::vector<std::unique_ptr<WorkerQueue>> queues;
+		std::vector<std::thread> workers;
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::condition_variable completion;
+		// Wakes the workers the core budget parks
+		std::condition_variable parking;
+		std::atomic<unsigned long> pendingTasks = 0;
+		std::atomic<unsigned long> nextQueue = 0;
+		bool stopping = false;
+		// Worker i is pinned to cpus[i % cpus.size()], no pinning when empty
+		std::vector<unsigned long> cpus;
+		HostPool *hostPool = 0;
+		// Runners posted to the host pool that have not finished yet
+		std::atomic<unsigned long> hostRunners = 0;
+		// Workers asked for, 0 when sized automatically, and those the core budget currently lets run
+		unsigned long requestedWorkers = 0;
+		std::atomic<unsigned long> activeWorkers = 0;
+		std::mutex exceptionMutex;
+		std::exception_ptr taskException;
+		Executor(const unsigned long &numberOfThreads = 0, const std::vector<unsigned long> &cpus = {});
+		Executor(HostPool &hostPool);
+		Executor(const Executor &) = delete;
+		Executor(Executor &&) = delete;
+		~Executor();
+		void submit(Task task, const Priority &priority = Inherit);
+		const bool tryRunOne();
+		void wait(const std::atomic<unsigned long> &remaining);
+		void notifyCompletion();
+		std::exception_ptr takeTaskException();
+		void parallelFor(const unsigned long &begin, const unsigned long &end, const unsigned long &grainSize, const std::function<void(unsigned long, unsigned long)> &function);
+		const unsigned long size() const;
+		const long currentWorker() const;
+		static Executor &shared();
+		static void setCoreBudget(const unsigned long &cores);
+		static const unsigned long coreBudget();
+	private:
+		const bool takeTask(const unsigned long &queueIndex, const Priority &priority, Task &task);
+		void workerLoop(const unsigned long workerIndex);
+	};
+}
+/*
+ */
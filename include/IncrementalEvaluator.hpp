@@ -0,0 +1,40 @@
+/*
+ */
+#pragma once
+#include <NeuralNetwork.hpp>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Stateful forward evaluation for input streams where only a few values change between calls. The
+	 * pre-activations of every layer are cached; the inputs that changed update them through their weight columns,
+	 * and a neuron's change is only passed on to the next layer when its activation moved by more than epsilon.
+	 * The cache is rebuilt from scratch when the network's parametersVersion changes and every refreshInterval
+	 * updates to bound rounding drift. Weights are read as long double, so the network must use Extended weight
+	 * precision, and the exact activation is used.
+	 */
+	struct IncrementalEvaluator
+	{
+		NeuralNetwork &network;
+		long double epsilon;
+		unsigned long refreshInterval;
+		unsigned long parametersVersion = 0;
+		unsigned long updatesSinceRefresh = 0;
+		bool primed = false;
+		std::vector<std::vector<long double>> preActivations;
+		std::vector<std::vector<long double>> activations;
+		std::vector<unsigned long> changedIndices;
+		std::vector<long double> changedDeltas;
+		std::vector<unsigned long> nextChangedIndices;
+		std::vector<long double> nextChangedDeltas;
+		IncrementalEvaluator(NeuralNetwork &network, const long double &epsilon = 0, const unsigned long &refreshInterval = 1024);
+		const std::vector<long double> &evaluate(const std::vector<long double> &inputValues);
+		const std::vector<long double> &outputs() const;
+		void reset();
+	private:
+		void evaluateFully(const std::vector<long double> &inputValues);
+	};
+}
+/*
+ */
@@ -0,0 +1,58 @@
+/*
+ */
+#pragma once
+#include <NeuralNetwork.hpp>
+#include <list>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Size-bounded, sharded LRU cache in front of NeuralNetwork::predict. Inputs are optionally snapped to a grid of
+	 * the given tolerance, hashed, and compared in full on lookup. Each shard remembers the parametersVersion its
+	 * entries were computed with and is emptied when the network's version moves on; setNetwork rebinds the cache
+	 * after a reload.
+	 */
+	struct InferenceCache
+	{
+		struct Entry
+		{
+			uint64_t hash;
+			std::vector<long double> key;
+			std::vector<long double> outputs;
+		};
+		struct Shard
+		{
+			std::mutex mutex;
+			std::list<Entry> entries;
+			std::unordered_multimap<uint64_t, std::list<Entry>::iterator> index;
+			unsigned long parametersVersion = 0;
+		};
+		struct Statistics
+		{
+			unsigned long hits = 0;
+			unsigned long misses = 0;
+			unsigned long evictions = 0;
+			unsigned long invalidations = 0;
+			const double hitRate() const;
+		};
+		NeuralNetwork *network;
+		unsigned long shardCapacity;
+		long double tolerance;
+		std::vector<std::unique_ptr<Shard>> shards;
+		std::atomic<unsigned long> hits = 0;
+		std::atomic<unsigned long> misses = 0;
+		std::atomic<unsigned long> evictions = 0;
+		std::atomic<unsigned long> invalidations = 0;
+		InferenceCache(NeuralNetwork &network, const unsigned long &capacity, const unsigned long &shardsCount = 16, const long double &tolerance = 0);
+		const std::vector<long double> predict(const std::vector<long double> &inputValues);
+		void setNetwork(NeuralNetwork &network);
+		void clear();
+		const Statistics statistics() const;
+	private:
+		const std::vector<long double> makeKey(const std::vector<long double> &inputValues) const;
+		static const uint64_t hashKey(const std::vector<long double> &key);
+	};
+}
+/*
+ */
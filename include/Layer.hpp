@@ -2,17 +2,77 @@
 */
 #pragma once
 #include "./Neuron.hpp"
+#include "./Precision.hpp"
 /*
  */
 namespace nnpp
 {
 	struct Layer
 	{
+		enum Type
+		{
+			Dense,
+			Convolution,
+			MaxPooling,
+			AveragePooling
+		};
+		enum Schedule
+		{
+			Automatic,
+			Serial,
+			Parallel
+		};
 		std::vector<Neuron> neurons;
+		// Storage of a dense layer's weights. Extended keeps them in the neurons as long double. Reduced precisions
+		// keep them row-major in packedWeights, the only copy unless float masterWeights are kept for the updates,
+		// and leave the neurons' weights empty
+		Precision::Type weightPrecision = Precision::Extended;
+		std::vector<uint16_t> packedWeights;
+		std::vector<float> masterWeights;
+		Type type = Dense;
+		// Geometry of convolution and pooling layers. Inputs and outputs are laid out channel-major as
+		// channels x height x width, one-dimensional layers have a height of 1
+		unsigned long inputChannels = 0;
+		unsigned long inputHeight = 0;
+		unsigned long inputWidth = 0;
+		unsigned long outputChannels = 0;
+		unsigned long outputHeight = 0;
+		unsigned long outputWidth = 0;
+		unsigned long kernelHeight = 0;
+		unsigned long kernelWidth = 0;
+		unsigned long strideHeight = 1;
+		unsigned long strideWidth = 1;
+		unsigned long paddingHeight = 0;
+		unsigned long paddingWidth = 0;
+		// Shared kernels of a convolution, row-major outputChannels x (inputChannels * kernelHeight * kernelWidth)
+		std::vector<long double> kernelWeights;
+		std::vector<long double> kernelBiases;
+		// Input index selected by each output of a max pooling layer in the last forward pass
+		std::vector<unsigned long> poolIndices;
+		// Kernel plan of a dense layer, usually set by Autotuner. Automatic and a block size of 0 defer to the
+		// network's parallelThreshold and backwardBlockSize
+		Schedule schedule = Automatic;
+		unsigned long backwardBlockSize = 0;
 		Layer() = default;
 		Layer(const unsigned long &numberOfNeurons, const unsigned long &numberOfInputsPerNeuron);
+		Layer(const Layer &other) = default;
 		Layer &operator=(const Layer &other);
+		void pack(const Precision::Type &precision, const bool &keepMasterWeights);
+		const long double weight(const unsigned long &neuronIndex, const unsigned long &inputIndex) const;
+		void setWeight(const unsigned long &neuronIndex, const unsigned long &inputIndex, const long double &value);
+		const unsigned long inputsSize() const;
+		static Layer convolution1D(const unsigned long &inputChannels, const unsigned long &inputLength, const unsigned long &outputChannels,
+			const unsigned long &kernelSize, const unsigned long &stride = 1, const unsigned long &padding = 0);
+		static Layer convolution2D(const unsigned long &inputChannels, const unsigned long &inputHeight, const unsigned long &inputWidth,
+			const unsigned long &outputChannels, const unsigned long &kernelHeight, const unsigned long &kernelWidth,
+			const unsigned long &stride = 1, const unsigned long &padding = 0);
+		static Layer pooling1D(const Type &type, const unsigned long &channels, const unsigned long &inputLength, const unsigned long &size, const unsigned long &stride = 0);
+		static Layer pooling2D(const Type &type, const unsigned long &channels, const unsigned long &inputHeight, const unsigned long &inputWidth, const unsigned long &size, const unsigned long &stride = 0);
+	private:
+		void setGeometry(const Type &type, const unsigned long &inputChannels, const unsigned long &inputHeight, const unsigned long &inputWidth,
+			const unsigned long &outputChannels, const unsigned long &kernelHeight, const unsigned long &kernelWidth,
+			const unsigned long &strideHeight, const unsigned long &strideWidth, const unsigned long &paddingHeight, const unsigned long &paddingWidth);
 	};
 }
 /*
- */
\ No newline at end of file
+ */
@@ -0,0 +1,65 @@
+/*
+ */
+#pragma once
+#include <NeuralNetwork.hpp>
+#include <future>
+#include <list>
+#include <map>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Loads models from .nrl files on demand and keeps the recently used ones resident within a memory budget,
+	 * evicting the least recently used models first. Handles are shared_ptrs, so an evicted model stays alive
+	 * until its last in-flight user lets go; only the registry's own reference is dropped. A model larger than the
+	 * whole budget is still served, everything else is evicted to make room for it. Each model is loaded once,
+	 * concurrent acquires and prefetches of a loading model wait for that load.
+	 */
+	struct ModelRegistry
+	{
+		struct Statistics
+		{
+			// A miss is an acquire that had to start the load itself, waiting on a prefetch counts as a hit
+			unsigned long hits = 0;
+			unsigned long misses = 0;
+			unsigned long loads = 0;
+			unsigned long evictions = 0;
+			double loadSeconds = 0;
+			unsigned long bytes = 0;
+			bool resident = false;
+			const double hitRate() const;
+			const double meanLoadSeconds() const;
+		};
+		struct Entry
+		{
+			std::shared_ptr<NeuralNetwork> network;
+			std::shared_future<std::shared_ptr<NeuralNetwork>> loading;
+			std::list<std::string>::iterator recency;
+			Statistics statistics;
+		};
+		unsigned long memoryBudget;
+		Executor *executor = 0;
+		ModelRegistry(const unsigned long &memoryBudget);
+		ModelRegistry(const ModelRegistry &) = delete;
+		~ModelRegistry();
+		std::shared_ptr<NeuralNetwork> acquire(const std::string &path);
+		void prefetch(const std::string &path);
+		void evict(const std::string &path);
+		const Statistics statistics(const std::string &path);
+		const unsigned long residentBytes();
+	private:
+		std::mutex mutex;
+		std::map<std::string, Entry> entries;
+		// Most recently used first
+		std::list<std::string> recency;
+		unsigned long totalBytes = 0;
+		std::atomic<unsigned long> pendingPrefetches = 0;
+		std::shared_ptr<std::promise<std::shared_ptr<NeuralNetwork>>> beginLoad(Entry &entry);
+		void load(const std::string &path, std::promise<std::shared_ptr<NeuralNetwork>> &promise);
+		void release(Entry &entry);
+		void enforceBudget();
+	};
+}
+/*
+ */
@@ -0,0 +1,37 @@
+/*
+ */
+#pragma once
+#include <NeuralNetwork.hpp>
+#include <memory>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * K networks with identical layer sizes and activation, packed so that the weights of all models for one
+	 * connection are adjacent: weight (neuron j, input i) of model k lives at (j * inputs + i) * K + k. A single pass
+	 * evaluates every model with the model index as the innermost, vectorizable loop. Parameters are stored as
+	 * double; activations go through Activations with the chosen accuracy.
+	 */
+	struct NetworkEnsemble
+	{
+		enum Aggregation
+		{
+			Mean,
+			Median
+		};
+		unsigned long modelsSize = 0;
+		std::vector<unsigned long> layerSizes;
+		std::vector<std::vector<double>> layerWeights;
+		std::vector<std::vector<double>> layerBiases;
+		NeuralNetwork::ActivationType activationType = NeuralNetwork::Sigmoid;
+		NeuralNetwork::ActivationAccuracy activationAccuracy = NeuralNetwork::Exact;
+		NetworkEnsemble(const std::vector<std::shared_ptr<NeuralNetwork>> &networks, const NeuralNetwork::ActivationAccuracy &activationAccuracy = NeuralNetwork::Exact);
+		void refresh(const std::vector<std::shared_ptr<NeuralNetwork>> &networks);
+		void predict(const long double *inputValues, double *outputValues, std::vector<double> &scratch) const;
+		const std::vector<std::vector<long double>> predict(const std::vector<long double> &inputValues) const;
+		const std::vector<long double> aggregate(const std::vector<long double> &inputValues, const Aggregation &aggregation = Mean) const;
+	};
+}
+/*
+ */
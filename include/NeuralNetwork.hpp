@@ -2,8 +2,16 @@
 */
 #pragma once
 #include "./Layer.hpp"
+#include "./Executor.hpp"
+#include "./Dataset.hpp"
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <atomic>
 #include <unordered_map>
+#include <memory>
 #include <mutex>
+#include <string>
 /*
  */
 namespace bs
@@ -16,6 +24,24 @@ namespace nnpp
 	#define DerivativeFunction const long double(*)(const long double &)
 	#define ActivationFunctionD(NAME) const long double(*NAME)(const long double &)
 	#define DerivativeFunctionD(NAME) const long double(*NAME)(const long double &)
+	struct NeuralNetwork;
+	/*
+	 * Returned by NeuralNetwork::infer, suspends the awaiting coroutine until the network's executor has produced
+	 * the outputs and resumes it on that executor's thread
+	 */
+	struct InferenceAwaitable
+	{
+		NeuralNetwork &network;
+		std::vector<long double> inputValues;
+		std::vector<long double> outputValues;
+		std::exception_ptr exception;
+		bool await_ready() const noexcept
+		{
+			return false;
+		};
+		void await_suspend(std::coroutine_handle<> handle);
+		std::vector<long double> await_resume();
+	};
 	struct NeuralNetwork
 	{
 		enum ActivationType
@@ -25,24 +51,107 @@ namespace nnpp
 			Tanh,
 			Swish
 		};
+		enum ActivationAccuracy
+		{
+			Exact,
+			HighAccuracy,
+			Fast
+		};
+		// SoftmaxCrossEntropy replaces the output layer's activation with a softmax trained on the cross-entropy
+		// loss, whose gradient with respect to the output layer's inputs is simply target - output
+		enum OutputMode
+		{
+			ActivationOutput,
+			SoftmaxCrossEntropy
+		};
+		// Flags selecting what evaluate computes
+		enum Metric
+		{
+			MeanSquaredError = 1,
+			MeanAbsoluteError = 2,
+			CrossEntropy = 4,
+			Accuracy = 8,
+			MaxError = 16,
+			AllMetrics = 31
+		};
+		/*
+		 * Squared and absolute errors are averaged over every output of every sample. The cross-entropy is the
+		 * categorical one per sample in SoftmaxCrossEntropy mode, otherwise the binary one per output, which assumes
+		 * outputs in [0, 1]. A sample is accurate when the largest output matches the largest target, or for a single
+		 * output when both are on the same side of 0.5. Metrics that were not requested stay 0.
+		 */
+		struct Evaluation
+		{
+			long double meanSquaredError = 0;
+			long double meanAbsoluteError = 0;
+			long double crossEntropy = 0;
+			long double accuracy = 0;
+			long double maxError = 0;
+			unsigned long samples = 0;
+		};
 		typedef std::unordered_map<ActivationType, std::pair<ActivationFunction, DerivativeFunction>> ActivationDerivativesMap;
 		static ActivationDerivativesMap activationDerivatives;
 		std::vector<Layer> layers;
 		long double learningRate = 0.13;
 		ActivationType activationType = Sigmoid;
+		ActivationAccuracy activationAccuracy = Exact;
+		OutputMode outputMode = ActivationOutput;
 		ActivationFunctionD(activation);
 		DerivativeFunctionD(derivative);
 		std::mutex mutex;
+		// Incremented whenever backpropagate or setWeightPrecision changes the parameters
+		std::atomic<unsigned long> parametersVersion = 0;
+		Executor *executor = 0;
+		Precision::Type weightPrecision = Precision::Extended;
+		bool keepMasterWeights = true;
+		std::vector<float> precisionScratch;
+		std::vector<long double> valuesScratch;
+		std::vector<long double> errorScratch;
+		std::vector<double> activationScratch;
+		// im2col matrix of a convolution's inputs and its product or error counterpart
+		std::vector<long double> columnsScratch;
+		std::vector<long double> productsScratch;
+		// Number of previous-layer columns processed per tile in backpropagate
+		unsigned long backwardBlockSize = 256;
+		// Layers with at least parallelThreshold weights are split across the executor's workers in chunks of at
+		// least parallelGrainSize weights, smaller layers stay on the calling thread
+		unsigned long parallelThreshold = 1ul << 18;
+		unsigned long parallelGrainSize = 1ul << 15;
 		NeuralNetwork() = default;
 		NeuralNetwork(const std::vector<unsigned long> &layerSizes, const ActivationType &activationType = Sigmoid);
+		NeuralNetwork(const std::vector<Layer> &layers, const ActivationType &activationType = Sigmoid);
 		NeuralNetwork(bs::ByteStream &byteStream);
 		NeuralNetwork(const NeuralNetwork &) = delete;
 		NeuralNetwork(NeuralNetwork &&) = delete;
 		void print();
 		void feedforward(const std::vector<long double> &inputValues);
 		void backpropagate(const std::vector<long double> &targetValues);
+		void backpropagateBlock(const unsigned long &layerIndex, const unsigned long &columnBegin, const unsigned long &columnEnd);
 		const std::vector<long double> getOutputs() const;
+		const std::vector<long double> predict(const std::vector<long double> &inputValues);
+		std::future<std::vector<long double>> inferAsync(const std::vector<long double> &inputValues);
+		InferenceAwaitable infer(const std::vector<long double> &inputValues);
+		Executor &getExecutor();
+		void propagateForward(const std::vector<long double> &inputValues);
+		void forEachNeuron(const Layer &layer, const unsigned long &inputsSize, const std::function<void(unsigned long, unsigned long)> &function);
+		const bool isParallel(const Layer &layer, const unsigned long &weightsSize) const;
+		void activateLayer(Layer &layer);
+		void activateSoftmax(Layer &layer);
+		void propagateConvolution(const unsigned long &layerIndex);
+		void propagatePooling(const unsigned long &layerIndex);
+		void backpropagateConvolution(const unsigned long &layerIndex);
+		void backpropagatePooling(const unsigned long &layerIndex);
+		const bool isDense() const;
+		const std::vector<long double> collectOutputs() const;
 		bs::ByteStream serialize() const;
+		void copyModel(const NeuralNetwork &source);
+		void setWeightPrecision(const Precision::Type &precision, const bool &keepMasterWeights = true);
+		const unsigned long memoryBytes() const;
+		const Evaluation evaluate(const Dataset &dataset, const unsigned long &metrics = AllMetrics);
+		const std::vector<long double> getParameters();
+		void setParameters(const std::vector<long double> &parameters);
+		void save(const std::string &filename) const;
+		static std::shared_ptr<NeuralNetwork> load(const std::string &filename);
 	};
 }
 /*
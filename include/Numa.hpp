@@ -0,0 +1,26 @@
+/*
+ */
+#pragma once
+#include <vector>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * NUMA topology and placement helpers. On Linux the topology comes from /sys/devices/system/node, memory is
+	 * placed by first touch from a thread pinned to the target node, and huge pages are requested with
+	 * madvise(MADV_HUGEPAGE). Other platforms report a single node.
+	 */
+	struct Numa
+	{
+		static const unsigned long nodeCount();
+		static const std::vector<unsigned long> nodeCpus(const unsigned long &node);
+		static const unsigned long currentNode();
+		static const bool pinThreadToNode(const unsigned long &node);
+		static const bool pinThreadToCpus(const std::vector<unsigned long> &cpus);
+		static void *allocate(const unsigned long &bytes, const bool &hugePages = false);
+		static void deallocate(void *pointer, const unsigned long &bytes);
+	};
+}
+/*
+ */
@@ -0,0 +1,60 @@
+/*
+ */
+#pragma once
+#include <NeuralNetwork.hpp>
+#include <PackedNetwork.hpp>
+#include <BoundedQueue.hpp>
+#include <atomic>
+#include <memory>
+#include <thread>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Serves inference from a published PackedNetwork while a private copy of the network keeps learning.
+	 * publish swaps in a new snapshot with one atomic store, so readers never take a lock and always see one
+	 * consistent model. Old snapshots are reclaimed after a grace period: readers register in one of two epoch
+	 * counters, and publish flips the epoch and waits for the previous epoch's readers to leave before deleting
+	 * the snapshot they might be using. Only publish can wait, never predict. The network must be one
+	 * PackedNetwork supports, the constructor throws otherwise.
+	 */
+	struct OnlineLearner
+	{
+		struct Feedback
+		{
+			std::vector<long double> inputValues;
+			std::vector<long double> targetValues;
+		};
+		struct alignas(64) ReaderCounter
+		{
+			std::atomic<unsigned long> count = 0;
+		};
+		static const unsigned long readerStripes = 16;
+		std::unique_ptr<NeuralNetwork> network;
+		std::atomic<PackedNetwork *> snapshot = 0;
+		std::atomic<unsigned long> epoch = 0;
+		ReaderCounter readers[2][readerStripes];
+		std::atomic<unsigned long> publishedVersion = 0;
+		// Samples learned between automatic publishes, 0 publishes only on request
+		unsigned long publishInterval;
+		unsigned long samplesSincePublish = 0;
+		// Serialises learn and publish, which may be called from several threads
+		std::mutex learnerMutex;
+		BoundedQueue<Feedback> feedbackQueue;
+		std::thread learnerThread;
+		OnlineLearner(const NeuralNetwork &network, const unsigned long &publishInterval = 64, const unsigned long &feedbackCapacity = 1024);
+		OnlineLearner(const OnlineLearner &) = delete;
+		~OnlineLearner();
+		const std::vector<long double> predict(const std::vector<long double> &inputValues);
+		void learn(const std::vector<long double> &inputValues, const std::vector<long double> &targetValues);
+		void publish();
+		void start();
+		void stop();
+		const bool feedback(const std::vector<long double> &inputValues, const std::vector<long double> &targetValues);
+	private:
+		void publishLocked();
+	};
+}
+/*
+ */
@@ -0,0 +1,40 @@
+/*
+ */
+#pragma once
+#include <NeuralNetwork.hpp>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Read-only copy of a NeuralNetwork's parameters packed into one contiguous block (row-major weights followed
+	 * by biases, per layer). Memory comes from Numa::allocate and is first touched by the constructing thread, so
+	 * building it on a pinned thread places it on that thread's node. predict is const and lock free, so any
+	 * number of threads may share one PackedNetwork.
+	 *
+	 * predict computes exactly what the network's predict does, including its activation accuracy. Networks
+	 * with reduced weight precision run float kernels that are not replicated here, the constructor rejects them
+	 * and supports tells callers to fall back to NeuralNetwork::predict.
+	 */
+	struct PackedNetwork
+	{
+		std::vector<unsigned long> layerSizes;
+		std::vector<unsigned long> layerOffsets;
+		long double *parameters = 0;
+		unsigned long parametersSize = 0;
+		unsigned long maxLayerSize = 0;
+		NeuralNetwork::ActivationType activationType = NeuralNetwork::Sigmoid;
+		NeuralNetwork::OutputMode outputMode = NeuralNetwork::ActivationOutput;
+		NeuralNetwork::ActivationAccuracy activationAccuracy = NeuralNetwork::Exact;
+		ActivationFunctionD(activation);
+		PackedNetwork(const NeuralNetwork &network, const bool &hugePages = false);
+		PackedNetwork(const PackedNetwork &) = delete;
+		PackedNetwork(PackedNetwork &&) = delete;
+		~PackedNetwork();
+		void predict(const long double *inputValues, long double *outputValues, long double *scratch) const;
+		const std::vector<long double> predict(const std::vector<long double> &inputValues) const;
+		static const bool supports(const NeuralNetwork &network);
+	};
+}
+/*
+ */
@@ -0,0 +1,26 @@
+/*
+ */
+#pragma once
+#include <vector>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Collective operations between the processes of a distributed training job. Every rank must call the same
+	 * operations in the same order. Values are exchanged in the native long double representation, so all ranks
+	 * must run on the same architecture.
+	 */
+	struct ParameterTransport
+	{
+		virtual ~ParameterTransport() = default;
+		virtual const unsigned long rank() const = 0;
+		virtual const unsigned long worldSize() const = 0;
+		// Replaces values on every rank with their element-wise sum over all ranks, added in rank order
+		virtual void allReduce(std::vector<long double> &values) = 0;
+		// Replaces bytes on every rank with the bytes of rank 0
+		virtual void broadcast(std::vector<char> &bytes) = 0;
+	};
+}
+/*
+ */
@@ -0,0 +1,99 @@
+/*
+ */
+#pragma once
+#include <NeuralNetwork.hpp>
+#include <BoundedQueue.hpp>
+#include <Dataset.hpp>
+#include <condition_variable>
+#include <memory>
+#include <thread>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Pipeline-parallel training: the layers are split into contiguous stages, each run by its own thread, and
+	 * every batch is streamed through them as micro-batches (GPipe schedule). A stage runs the forward pass of all
+	 * micro-batches of a batch, then their backward passes, and applies the mean gradient to its layers when the
+	 * batch is flushed, so all micro-batches of a batch see the same weights. The calling thread runs the first
+	 * stage and every other stage has a worker started by the constructor and kept until destruction, so train
+	 * calls do not create threads. Reduced precision networks are evaluated from their packed weights, as in
+	 * NeuralNetwork::feedforward, and updated through their float master weights when kept.
+	 *
+	 * Every layer's activations are kept for the backward pass by default. With a checkpoint interval k a stage
+	 * only keeps the activations of every k-th layer and recomputes the others one segment at a time during the
+	 * backward pass, trading a second forward pass for memory; the results are unchanged. Setting memoryBudget
+	 * picks the smallest interval whose estimated activation memory fits.
+	 */
+	struct PipelineTrainer
+	{
+		struct MicroBatch
+		{
+			unsigned long index = 0;
+			// One row of activations or errors per sample
+			std::vector<std::vector<long double>> values;
+		};
+		struct Stage
+		{
+			// Layers [layerBegin, layerEnd) are trained by this stage
+			unsigned long layerBegin = 0;
+			unsigned long layerEnd = 0;
+			// Row-major weight gradients and bias gradients per layer, accumulated until the batch is flushed
+			std::vector<std::vector<long double>> weightGradients;
+			std::vector<std::vector<long double>> biasGradients;
+			double busySeconds = 0;
+			// Activation values currently held for the backward pass and their peak
+			unsigned long stashedValues = 0;
+			unsigned long peakStashedValues = 0;
+		};
+		struct StageStatistics
+		{
+			unsigned long layerBegin = 0;
+			unsigned long layerEnd = 0;
+			double busySeconds = 0;
+			// Fraction of the last train call the stage spent computing rather than waiting on its queues
+			double utilisation = 0;
+			unsigned long peakActivationBytes = 0;
+		};
+		NeuralNetwork &network;
+		unsigned long microBatchSize;
+		unsigned long queueCapacity;
+		std::vector<Stage> stages;
+		double elapsedSeconds = 0;
+		unsigned long checkpointInterval = 1;
+		// In bytes, 0 uses checkpointInterval as set
+		unsigned long memoryBudget = 0;
+		// Interval used by the last train call
+		unsigned long effectiveCheckpointInterval = 1;
+		PipelineTrainer(NeuralNetwork &network, const unsigned long &stagesCount, const unsigned long &microBatchSize = 1, const unsigned long &queueCapacity = 4);
+		PipelineTrainer(const PipelineTrainer &) = delete;
+		~PipelineTrainer();
+		const long double train(const Dataset &dataset, const unsigned long &batchSize);
+		const std::vector<StageStatistics> statistics() const;
+		const unsigned long activationBytes(const unsigned long &interval, const unsigned long &samplesCount) const;
+		const unsigned long chooseCheckpointInterval(const unsigned long &samplesCount) const;
+	private:
+		std::vector<std::unique_ptr<BoundedQueue<MicroBatch>>> forwardQueues;
+		std::vector<std::unique_ptr<BoundedQueue<MicroBatch>>> backwardQueues;
+		std::vector<std::thread> workers;
+		// Every train call starts a new round, which the workers wait for and report back on through roundCondition
+		std::mutex roundMutex;
+		std::condition_variable roundCondition;
+		unsigned long round = 0;
+		unsigned long stagesRunning = 0;
+		bool stopping = false;
+		const Dataset *roundDataset = 0;
+		unsigned long roundBatchSize = 0;
+		long double roundLoss = 0;
+		std::exception_ptr roundException;
+		void runWorker(const unsigned long &stageIndex);
+		void runRound(const unsigned long &stageIndex);
+		void runStage(const unsigned long &stageIndex, const Dataset &dataset, const unsigned long &batchSize, long double &loss);
+		void propagate(const unsigned long &layerIndex, const std::vector<long double> &inputs, std::vector<long double> &outputs);
+		void forward(Stage &stage, MicroBatch &microBatch, std::vector<std::vector<long double>> &stash);
+		void backward(Stage &stage, MicroBatch &microBatch, std::vector<std::vector<long double>> &stash);
+		void flush(Stage &stage, const unsigned long &samplesCount);
+	};
+}
+/*
+ */
@@ -0,0 +1,44 @@
+/*
+ */
+#pragma once
+#include <NeuralNetwork.hpp>
+#include <Dataset.hpp>
+#include <memory>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Trains many independent networks on the work-stealing Executor with successive halving: every rung trains
+	 * the surviving jobs up to the rung's epoch budget, ranks them by validation loss and keeps the best
+	 * 1 / reductionFactor. The budget grows by reductionFactor per rung until each job reaches its own epochs.
+	 * A reductionFactor below 2 trains every job to completion. When a job throws, the rung's other jobs still
+	 * finish and train rethrows the first exception.
+	 */
+	struct PopulationTrainer
+	{
+		struct Job
+		{
+			std::shared_ptr<NeuralNetwork> network;
+			std::shared_ptr<const Dataset> trainingSet;
+			// Defaults to the training set when null
+			std::shared_ptr<const Dataset> validationSet;
+			unsigned long epochs = 0;
+		};
+		struct Result
+		{
+			std::shared_ptr<NeuralNetwork> network;
+			long double loss = 0;
+			unsigned long epochsTrained = 0;
+			unsigned long rungsCompleted = 0;
+			bool terminated = false;
+		};
+		Executor *executor = 0;
+		unsigned long minimumEpochs = 256;
+		unsigned long reductionFactor = 3;
+		const std::vector<Result> train(const std::vector<Job> &jobs);
+		static const long double meanSquaredError(NeuralNetwork &network, const Dataset &dataset);
+	};
+}
+/*
+ */
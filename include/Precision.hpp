@@ -0,0 +1,31 @@
+/*
+ */
+#pragma once
+#include <cstdint>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Reduced precision weight storage. Weights are stored as IEEE half or bfloat16 and widened to float inside
+	 * the kernels, which accumulate in float. F16C/AVX2 paths are picked at runtime on x86-64.
+	 */
+	struct Precision
+	{
+		enum Type
+		{
+			Extended,
+			Half,
+			BFloat16
+		};
+		static const uint16_t toHalf(const float &value);
+		static const float fromHalf(const uint16_t &value);
+		static const uint16_t toBFloat16(const float &value);
+		static const float fromBFloat16(const uint16_t &value);
+		static const uint16_t narrow(const float &value, const Type &precision);
+		static const float widen(const uint16_t &value, const Type &precision);
+		static const float dot(const uint16_t *weights, const float *values, const unsigned long &size, const Type &precision);
+	};
+}
+/*
+ */
@@ -0,0 +1,38 @@
+/*
+ */
+#pragma once
+#include <cstdint>
+#include <string>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Software rasterizer over a caller owned 32-bit pixel buffer (row-major, width pixels per row). Every
+	 * primitive is clipped to the buffer, so shapes may extend past its edges. Filled shapes are drawn as
+	 * horizontal spans written with std::fill_n, which compilers turn into vector stores.
+	 */
+	struct Rasterizer
+	{
+		uint32_t *pixels;
+		int width;
+		int height;
+		Rasterizer(uint32_t *pixels, const int &width, const int &height);
+		// Pixels [x0, x1] of row y
+		void span(const int &y, int x0, int x1, const uint32_t &color);
+		void clear(const uint32_t &color);
+		void rect(const int &x, const int &y, const int &w, const int &h, const uint32_t &color);
+		// Filled, covers the pixels within radius of the center
+		void circle(const int &x, const int &y, const int &radius, const uint32_t &color);
+		// Bresenham line from (x0, y0) to (x1, y1), both ends included
+		void line(int x0, int y0, const int &x1, const int &y1, const uint32_t &color);
+		// Replaces the 4-connected region of the color at (x, y)
+		void fill(const int &x, const int &y, const uint32_t &color);
+		// 3x5 pixel font, each font pixel drawn as a scale x scale square
+		void text(int x, const int &y, const std::string &string, const int &scale, const uint32_t &color);
+		const bool contains(const int &x, const int &y) const;
+		const uint32_t pixel(const int &x, const int &y) const;
+	};
+}
+/*
+ */
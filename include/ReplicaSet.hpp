@@ -0,0 +1,32 @@
+/*
+ */
+#pragma once
+#include <PackedNetwork.hpp>
+#include <memory>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * One read-only PackedNetwork per NUMA node, each built on a thread pinned to its node so its pages are
+	 * node-local. predict reads the replica of the node the calling thread is running on; inference threads
+	 * should be pinned with Numa::pinThreadToNode so they stay next to their replica. refresh rebuilds every
+	 * replica and must not run concurrently with predict.
+	 * Replication only scales throughput across many concurrent requests: a single predict runs entirely on the
+	 * calling thread against one whole replica, so a wide layer's rows are not split across nodes and the latency
+	 * of one request does not improve with the node count.
+	 */
+	struct ReplicaSet
+	{
+		std::vector<std::unique_ptr<PackedNetwork>> replicas;
+		bool replicatePerNode;
+		bool hugePages;
+		ReplicaSet(const NeuralNetwork &network, const bool &replicatePerNode = true, const bool &hugePages = true);
+		void refresh(const NeuralNetwork &network);
+		const PackedNetwork &replica(const unsigned long &node) const;
+		const PackedNetwork &local() const;
+		const std::vector<long double> predict(const std::vector<long double> &inputValues) const;
+	};
+}
+/*
+ */
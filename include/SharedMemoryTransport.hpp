@@ -0,0 +1,40 @@
+/*
+ */
+#pragma once
+#include <ParameterTransport.hpp>
+#include <string>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * ParameterTransport between processes on one host over a POSIX shared memory segment. Every rank owns a slot
+	 * of capacity bytes, ranks meet at a process-shared barrier and all-reduce is a reduce-scatter in which each
+	 * rank sums its own segment of the slots. Rank 0 creates the segment and unlinks the name once all ranks are
+	 * attached, so the name can be reused by the next job. job identifies one launch and must be the same on every
+	 * rank and differ between launches that share a name: the other ranks only attach to a segment rank 0
+	 * initialised for their job, never to one left behind by a crashed job.
+	 */
+	struct SharedMemoryTransport : ParameterTransport
+	{
+		std::string name;
+		unsigned long rankIndex;
+		unsigned long ranksCount;
+		unsigned long capacity;
+		void *mapping = 0;
+		unsigned long mappingSize = 0;
+		SharedMemoryTransport(const std::string &name, const unsigned long &rank, const unsigned long &worldSize, const unsigned long &job, const unsigned long &capacity = 1ul << 26);
+		SharedMemoryTransport(const SharedMemoryTransport &) = delete;
+		~SharedMemoryTransport();
+		const unsigned long rank() const;
+		const unsigned long worldSize() const;
+		void allReduce(std::vector<long double> &values);
+		void broadcast(std::vector<char> &bytes);
+	private:
+		void map(const int &descriptor);
+		void barrier();
+		char *slot(const unsigned long &rank) const;
+	};
+}
+/*
+ */
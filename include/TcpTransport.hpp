@@ -0,0 +1,33 @@
+/*
+ */
+#pragma once
+#include <ParameterTransport.hpp>
+#include <string>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * ParameterTransport over TCP in a star: rank 0 listens on port and every other rank connects to host:port.
+	 * All-reduce gathers the values on rank 0, sums them in rank order and sends the result back.
+	 */
+	struct TcpTransport : ParameterTransport
+	{
+		unsigned long rankIndex;
+		unsigned long ranksCount;
+		// On rank 0 the socket of every other rank, indexed by rank, otherwise the socket to rank 0
+		std::vector<int> sockets;
+		TcpTransport(const std::string &host, const unsigned short &port, const unsigned long &rank, const unsigned long &worldSize, const unsigned long &timeoutMilliseconds = 30000);
+		TcpTransport(const TcpTransport &) = delete;
+		~TcpTransport();
+		const unsigned long rank() const;
+		const unsigned long worldSize() const;
+		void allReduce(std::vector<long double> &values);
+		void broadcast(std::vector<char> &bytes);
+	private:
+		static void sendAll(const int &socket, const void *data, const unsigned long &size);
+		static void receiveAll(const int &socket, void *data, const unsigned long &size);
+	};
+}
+/*
+ */
@@ -0,0 +1,83 @@
+/*
+ */
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+/*
+ */
+namespace nnpp
+{
+	/*
+	 * Span tracing exported as Chrome Trace Event JSON, which chrome://tracing and Perfetto open directly. Every
+	 * thread records into its own ring buffer with a single atomic store, so tracing takes no lock on the hot path;
+	 * when a buffer is full the oldest spans are overwritten. Names and categories must be string literals. While
+	 * tracing is stopped a span costs one relaxed load, building with NNPP_DISABLE_TRACING removes them entirely.
+	 */
+	struct Tracer
+	{
+		struct Event
+		{
+			const char *name = 0;
+			const char *category = 0;
+			unsigned long begin = 0;
+			unsigned long end = 0;
+			long argument = -1;
+		};
+		// Event fields are atomics so events() may copy a slot while its thread overwrites it
+		struct Slot
+		{
+			std::atomic<const char *> name = 0;
+			std::atomic<const char *> category = 0;
+			std::atomic<unsigned long> begin = 0;
+			std::atomic<unsigned long> end = 0;
+			std::atomic<long> argument = -1;
+		};
+		/*
+		 * Ring of slots written by one thread, seqlock style: claimed counts the slots whose writing has begun,
+		 * head those whose writing has finished
+		 */
+		struct Buffer
+		{
+			std::unique_ptr<Slot[]> slots;
+			unsigned long capacity = 0;
+			std::atomic<unsigned long> claimed = 0;
+			std::atomic<unsigned long> head = 0;
+			unsigned long threadIndex = 0;
+		};
+		/*
+		 * Records the span from construction to destruction, argument (a layer index for kernels) is omitted
+		 * when negative
+		 */
+		struct Scope
+		{
+			const char *name;
+			const char *category;
+			long argument;
+			unsigned long begin = 0;
+			bool active;
+			Scope(const char *name, const char *category, const long &argument = -1);
+			Scope(const Scope &) = delete;
+			~Scope();
+		};
+		static std::atomic<bool> enabled;
+		static void start(const unsigned long &eventsPerThread = 1ul << 16);
+		static void stop();
+		static const unsigned long now();
+		static void record(const char *name, const char *category, const unsigned long &begin, const unsigned long &end, const long &argument = -1);
+		static std::unique_lock<std::mutex> lock(std::mutex &mutex);
+		static const std::vector<Event> events();
+		static void write(const std::string &filename);
+	};
+}
+#define NNPP_TRACE_CONCATENATE_(A, B) A##B
+#define NNPP_TRACE_CONCATENATE(A, B) NNPP_TRACE_CONCATENATE_(A, B)
+#ifdef NNPP_DISABLE_TRACING
+#define NNPP_TRACE_SCOPE(...)
+#else
+#define NNPP_TRACE_SCOPE(...) nnpp::Tracer::Scope NNPP_TRACE_CONCATENATE(traceScope, __LINE__)(__VA_ARGS__)
+#endif
+/*
+ */
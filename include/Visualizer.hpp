@@ -2,6 +2,7 @@
  */
 #pragma once
 #include <NeuralNetwork.hpp>
+#include <Rasterizer.hpp>
 #include <thread>
 #include <memory>
 /*
@@ -16,22 +17,29 @@ namespace nnpp
 		uint8_t r;
 		uint8_t a;
 	};
+	/*
+	 * Draws the network into buf, continuously in its own window, or only when render is called in headless mode
+	 * (no window is opened, buf can be read back, e.g. by tests)
+	 */
 	struct Visualizer
-  {
-    NeuralNetwork &network;
-		std::thread windowThread;
+	{
+		NeuralNetwork &network;
 		unsigned int windowWidth;
 		unsigned int windowHeight;
 		std::shared_ptr<uint32_t> buf;
-		struct fenster *f;
-  	Visualizer(NeuralNetwork &network, const int &windowWidth, const int &windowHeight);
+		struct fenster *f = 0;
+		Rasterizer rasterizer;
+		bool headless;
+		// Started last, once everything it uses is initialized
+		std::thread windowThread;
+		Visualizer(NeuralNetwork &network, const int &windowWidth, const int &windowHeight, const bool &headless = false);
 		void close();
 		~Visualizer();
-    void render();
+		void render();
 		uint32_t mapValueToColor(long double value);
 		uint32_t mapWeightToColor(const Neuron &neuron);
 		void startWindow();
-  };
+	};
 }
 /*
- */
\ No newline at end of file
+ */
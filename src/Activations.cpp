@@ -0,0 +1,454 @@
+/*
+ */
+#include <Activations.hpp>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#if defined(__x86_64__) && defined(__linux__) && defined(__GNUC__)
+#define NNPP_TARGET_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define NNPP_TARGET_CLONES
+#endif
+using namespace nnpp;
+/*
+ * exp(x) = 2^n * (1 + p) with n = round(x / ln 2) and p = expm1(r) for the reduced argument r = x - n ln 2,
+ * |r| <= ln 2 / 2. Rounding uses the 1.5 * 2^52 shift so n is also available as integer bits.
+ */
+static const double roundingShift = 0x1.8p52;
+static const double log2e = 0x1.71547652b82fep0;
+static const double ln2High = 0x1.62e42fefa3800p-1;
+static const double ln2Low = 0x1.ef35793c76730p-45;
+static inline double expm1Reduced(double x, double &scale, double &n)
+{
+	x = (std::min)((std::max)(x, -708.0), 709.0);
+	double shifted = x * log2e + roundingShift;
+	n = shifted - roundingShift;
+	double r = (x - n * ln2High) - n * ln2Low;
+	uint64_t exponent = std::bit_cast<uint64_t>(shifted) - std::bit_cast<uint64_t>(roundingShift);
+	scale = std::bit_cast<double>((exponent + 1023) << 52);
+	// Taylor series of expm1 to degree 13, truncation error below 2^-60 on the reduced range
+	double p = 1.0 / 6227020800.0;
+	p = p * r + 1.0 / 479001600.0;
+	p = p * r + 1.0 / 39916800.0;
+	p = p * r + 1.0 / 3628800.0;
+	p = p * r + 1.0 / 362880.0;
+	p = p * r + 1.0 / 40320.0;
+	p = p * r + 1.0 / 5040.0;
+	p = p * r + 1.0 / 720.0;
+	p = p * r + 1.0 / 120.0;
+	p = p * r + 1.0 / 24.0;
+	p = p * r + 1.0 / 6.0;
+	p = p * r + 0.5;
+	p = p * r + 1.0;
+	return p * r;
+};
+static inline double expHigh(const double &x)
+{
+	double scale, n;
+	double p = expm1Reduced(x, scale, n);
+	return scale + scale * p;
+};
+static inline double expm1High(const double &x)
+{
+	double scale, n;
+	double p = expm1Reduced(x, scale, n);
+	double shifted = (scale - 1.0) + scale * p;
+	return n == 0.0 ? p : shifted;
+};
+static inline double tanhHigh(const double &x)
+{
+	double a = (std::min)(std::abs(x), 20.0);
+	double e = expm1High(2.0 * a);
+	return std::copysign(e / (e + 2.0), x);
+};
+static inline double sigmoidHigh(const double &x)
+{
+	return 1.0 / (1.0 + expHigh(-x));
+};
+/*
+ * Single precision variant of the same reduction with a degree 5 polynomial
+ */
+static const float roundingShiftFast = 0x1.8p23f;
+static const float log2eFast = 0x1.715476p0f;
+static const float ln2HighFast = 0x1.62e400p-1f;
+static const float ln2LowFast = 0x1.7f7d1cp-20f;
+static inline float expm1ReducedFast(float x, float &scale, float &n)
+{
+	x = (std::min)((std::max)(x, -87.0f), 88.0f);
+	float shifted = x * log2eFast + roundingShiftFast;
+	n = shifted - roundingShiftFast;
+	float r = (x - n * ln2HighFast) - n * ln2LowFast;
+	uint32_t exponent = std::bit_cast<uint32_t>(shifted) - std::bit_cast<uint32_t>(roundingShiftFast);
+	scale = std::bit_cast<float>((exponent + 127) << 23);
+	float p = 1.0f / 120.0f;
+	p = p * r + 1.0f / 24.0f;
+	p = p * r + 1.0f / 6.0f;
+	p = p * r + 0.5f;
+	p = p * r + 1.0f;
+	return p * r;
+};
+static inline float expFast(const float &x)
+{
+	float scale, n;
+	float p = expm1ReducedFast(x, scale, n);
+	return scale + scale * p;
+};
+static inline float expm1Fast(const float &x)
+{
+	float scale, n;
+	float p = expm1ReducedFast(x, scale, n);
+	float shifted = (scale - 1.0f) + scale * p;
+	return n == 0.0f ? p : shifted;
+};
+static inline float tanhFast(const float &x)
+{
+	float a = (std::min)(std::abs(x), 10.0f);
+	float e = expm1Fast(2.0f * a);
+	return std::copysign(e / (e + 2.0f), x);
+};
+static inline float sigmoidFast(const float &x)
+{
+	return 1.0f / (1.0f + expFast(-x));
+};
+/*
+ */
+NNPP_TARGET_CLONES
+static void activateHigh(const NeuralNetwork::ActivationType &activationType, double *values, const unsigned long size)
+{
+	switch (activationType)
+	{
+	case NeuralNetwork::Sigmoid:
+		for (unsigned long index = 0; index < size; index++)
+		{
+			values[index] = sigmoidHigh(values[index]);
+		}
+		break;
+	case NeuralNetwork::Tanh:
+		for (unsigned long index = 0; index < size; index++)
+		{
+			values[index] = tanhHigh(values[index]);
+		}
+		break;
+	case NeuralNetwork::Swish:
+		for (unsigned long index = 0; index < size; index++)
+		{
+			values[index] = values[index] * sigmoidHigh(values[index]);
+		}
+		break;
+	case NeuralNetwork::Linear:
+		break;
+	}
+};
+/*
+ */
+NNPP_TARGET_CLONES
+static void activateFast(const NeuralNetwork::ActivationType &activationType, double *values, const unsigned long size)
+{
+	switch (activationType)
+	{
+	case NeuralNetwork::Sigmoid:
+		for (unsigned long index = 0; index < size; index++)
+		{
+			values[index] = sigmoidFast((float)values[index]);
+		}
+		break;
+	case NeuralNetwork::Tanh:
+		for (unsigned long index = 0; index < size; index++)
+		{
+			values[index] = tanhFast((float)values[index]);
+		}
+		break;
+	case NeuralNetwork::Swish:
+		for (unsigned long index = 0; index < size; index++)
+		{
+			float value = (float)values[index];
+			values[index] = value * sigmoidFast(value);
+		}
+		break;
+	case NeuralNetwork::Linear:
+		break;
+	}
+};
+/*
+ */
+static void activateExact(const NeuralNetwork::ActivationType &activationType, double *values, const unsigned long size)
+{
+	for (unsigned long index = 0; index < size; index++)
+	{
+		double value = values[index];
+		switch (activationType)
+		{
+		case NeuralNetwork::Sigmoid:
+			values[index] = 1.0 / (1.0 + std::exp(-value));
+			break;
+		case NeuralNetwork::Tanh:
+			values[index] = std::tanh(value);
+			break;
+		case NeuralNetwork::Swish:
+			values[index] = value / (1.0 + std::exp(-value));
+			break;
+		case NeuralNetwork::Linear:
+			break;
+		}
+	}
+};
+/*
+ */
+void Activations::activate(const NeuralNetwork::ActivationType &activationType, const NeuralNetwork::ActivationAccuracy &accuracy, double *values, const unsigned long &size)
+{
+	switch (accuracy)
+	{
+	case NeuralNetwork::HighAccuracy:
+		activateHigh(activationType, values, size);
+		break;
+	case NeuralNetwork::Fast:
+		activateFast(activationType, values, size);
+		break;
+	case NeuralNetwork::Exact:
+		activateExact(activationType, values, size);
+		break;
+	}
+};
+/*
+ * The derivatives take the neuron's output value, like the long double derivatives in NeuralNetwork.cpp
+ */
+NNPP_TARGET_CLONES
+static void differentiateHigh(const NeuralNetwork::ActivationType &activationType, double *values, const unsigned long size)
+{
+	switch (activationType)
+	{
+	case NeuralNetwork::Sigmoid:
+		for (unsigned long index = 0; index < size; index++)
+		{
+			values[index] = values[index] * (1.0 - values[index]);
+		}
+		break;
+	case NeuralNetwork::Tanh:
+		// Evaluated at the output like NeuralNetwork::derivative, not 1 - y^2, see Activations.hpp
+		for (unsigned long index = 0; index < size; index++)
+		{
+			double tanhX = tanhHigh(values[index]);
+			values[index] = 1.0 - tanhX * tanhX;
+		}
+		break;
+	case NeuralNetwork::Swish:
+		for (unsigned long index = 0; index < size; index++)
+		{
+			// 1 - sigmoid(x) is formed as exp(-x) * sigmoid(x) to avoid cancellation for large x
+			double expX = expHigh(-values[index]);
+			double sigmoidX = 1.0 / (1.0 + expX);
+			values[index] = sigmoidX + values[index] * sigmoidX * (expX * sigmoidX);
+		}
+		break;
+	case NeuralNetwork::Linear:
+		for (unsigned long index = 0; index < size; index++)
+		{
+			values[index] = 1.0;
+		}
+		break;
+	}
+};
+/*
+ */
+NNPP_TARGET_CLONES
+static void differentiateFast(const NeuralNetwork::ActivationType &activationType, double *values, const unsigned long size)
+{
+	switch (activationType)
+	{
+	case NeuralNetwork::Sigmoid:
+		for (unsigned long index = 0; index < size; index++)
+		{
+			values[index] = values[index] * (1.0 - values[index]);
+		}
+		break;
+	case NeuralNetwork::Tanh:
+		for (unsigned long index = 0; index < size; index++)
+		{
+			float tanhX = tanhFast((float)values[index]);
+			values[index] = 1.0f - tanhX * tanhX;
+		}
+		break;
+	case NeuralNetwork::Swish:
+		for (unsigned long index = 0; index < size; index++)
+		{
+			float value = (float)values[index];
+			float expX = expFast(-value);
+			float sigmoidX = 1.0f / (1.0f + expX);
+			values[index] = sigmoidX + value * sigmoidX * (expX * sigmoidX);
+		}
+		break;
+	case NeuralNetwork::Linear:
+		for (unsigned long index = 0; index < size; index++)
+		{
+			values[index] = 1.0;
+		}
+		break;
+	}
+};
+/*
+ */
+static void differentiateExact(const NeuralNetwork::ActivationType &activationType, double *values, const unsigned long size)
+{
+	for (unsigned long index = 0; index < size; index++)
+	{
+		double value = values[index];
+		switch (activationType)
+		{
+		case NeuralNetwork::Sigmoid:
+			values[index] = value * (1.0 - value);
+			break;
+		case NeuralNetwork::Tanh:
+		{
+			double tanhX = std::tanh(value);
+			values[index] = 1.0 - tanhX * tanhX;
+			break;
+		}
+		case NeuralNetwork::Swish:
+		{
+			double sigmoidX = 1.0 / (1.0 + std::exp(-value));
+			values[index] = sigmoidX + value * sigmoidX * (1.0 - sigmoidX);
+			break;
+		}
+		case NeuralNetwork::Linear:
+			values[index] = 1.0;
+			break;
+		}
+	}
+};
+/*
+ */
+void Activations::differentiate(const NeuralNetwork::ActivationType &activationType, const NeuralNetwork::ActivationAccuracy &accuracy, double *values, const unsigned long &size)
+{
+	switch (accuracy)
+	{
+	case NeuralNetwork::HighAccuracy:
+		differentiateHigh(activationType, values, size);
+		break;
+	case NeuralNetwork::Fast:
+		differentiateFast(activationType, values, size);
+		break;
+	case NeuralNetwork::Exact:
+		differentiateExact(activationType, values, size);
+		break;
+	}
+};
+/*
+ */
+NNPP_TARGET_CLONES
+static void exponentiateHigh(double *values, const unsigned long size)
+{
+	for (unsigned long index = 0; index < size; index++)
+	{
+		values[index] = expHigh(values[index]);
+	}
+};
+/*
+ */
+NNPP_TARGET_CLONES
+static void exponentiateFast(double *values, const unsigned long size)
+{
+	for (unsigned long index = 0; index < size; index++)
+	{
+		values[index] = expFast((float)values[index]);
+	}
+};
+/*
+ * Subtracting the maximum (the log-sum-exp shift) keeps every exponent at or below zero, so nothing overflows and
+ * the sum is at least 1. The double form runs the vectorized exponentials, the long double one is the Exact
+ * softmax of NeuralNetwork and PackedNetwork.
+ */
+template <typename T>
+void Activations::softmax(const NeuralNetwork::ActivationAccuracy &accuracy, T *values, const unsigned long &size)
+{
+	if (size == 0)
+	{
+		return;
+	}
+	T maximum = *std::max_element(values, values + size);
+	for (unsigned long index = 0; index < size; index++)
+	{
+		values[index] -= maximum;
+	}
+	if constexpr (std::is_same_v<T, double>)
+	{
+		switch (accuracy)
+		{
+		case NeuralNetwork::HighAccuracy:
+			exponentiateHigh(values, size);
+			break;
+		case NeuralNetwork::Fast:
+			exponentiateFast(values, size);
+			break;
+		case NeuralNetwork::Exact:
+			for (unsigned long index = 0; index < size; index++)
+			{
+				values[index] = std::exp(values[index]);
+			}
+			break;
+		}
+	}
+	else
+	{
+		for (unsigned long index = 0; index < size; index++)
+		{
+			values[index] = accuracy == NeuralNetwork::Exact ? std::exp(values[index]) : exp((double)values[index], accuracy);
+		}
+	}
+	T sum = 0;
+	for (unsigned long index = 0; index < size; index++)
+	{
+		sum += values[index];
+	}
+	for (unsigned long index = 0; index < size; index++)
+	{
+		values[index] /= sum;
+	}
+};
+template void Activations::softmax<double>(const NeuralNetwork::ActivationAccuracy &accuracy, double *values, const unsigned long &size);
+template void Activations::softmax<long double>(const NeuralNetwork::ActivationAccuracy &accuracy, long double *values, const unsigned long &size);
+/*
+ */
+const double Activations::exp(const double &x, const NeuralNetwork::ActivationAccuracy &accuracy)
+{
+	switch (accuracy)
+	{
+	case NeuralNetwork::HighAccuracy:
+		return expHigh(x);
+	case NeuralNetwork::Fast:
+		return expFast((float)x);
+	default:
+		return std::exp(x);
+	}
+};
+/*
+ */
+const double Activations::tanh(const double &x, const NeuralNetwork::ActivationAccuracy &accuracy)
+{
+	switch (accuracy)
+	{
+	case NeuralNetwork::HighAccuracy:
+		return tanhHigh(x);
+	case NeuralNetwork::Fast:
+		return tanhFast((float)x);
+	default:
+		return std::tanh(x);
+	}
+};
+/*
+ */
+const double Activations::sigmoid(const double &x, const NeuralNetwork::ActivationAccuracy &accuracy)
+{
+	switch (accuracy)
+	{
+	case NeuralNetwork::HighAccuracy:
+		return sigmoidHigh(x);
+	case NeuralNetwork::Fast:
+		return sigmoidFast((float)x);
+	default:
+		return 1.0 / (1.0 + std::exp(-x));
+	}
+};
+/*
+ */
@@ -0,0 +1,199 @@
+/*
+ */
+#include <Autotuner.hpp>
+#include <Random.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+using namespace nnpp;
+/*
+ */
+Autotuner::Autotuner(const std::string &cachePath):
+	cachePath(cachePath),
+	cpuModel(readCpuModel())
+{
+	load();
+};
+/*
+ * The "model name" of the first processor in /proc/cpuinfo, "unknown" elsewhere
+ */
+const std::string Autotuner::readCpuModel()
+{
+	std::ifstream file("/proc/cpuinfo");
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (line.rfind("model name", 0) != 0)
+		{
+			continue;
+		}
+		auto separator = line.find(':');
+		if (separator == std::string::npos)
+		{
+			break;
+		}
+		auto model = line.substr(line.find_first_not_of(" \t", separator + 1));
+		// Tabs separate the cache's fields
+		std::replace(model.begin(), model.end(), '\t', ' ');
+		return model;
+	}
+	return "unknown";
+};
+/*
+ */
+const std::string Autotuner::key(const unsigned long &inputsSize, const unsigned long &neuronsSize, const unsigned long &workers, const Precision::Type &precision) const
+{
+	return cpuModel + "\t" + std::to_string(inputsSize) + "\t" + std::to_string(neuronsSize) + "\t" + std::to_string(workers) + "\t" +
+		std::to_string((unsigned long)precision);
+};
+/*
+ */
+const bool Autotuner::find(const unsigned long &inputsSize, const unsigned long &neuronsSize, const unsigned long &workers, const Precision::Type &precision, Plan &plan) const
+{
+	auto iterator = plans.find(key(inputsSize, neuronsSize, workers, precision));
+	if (iterator == plans.end())
+	{
+		return false;
+	}
+	plan = iterator->second;
+	return true;
+};
+/*
+ * One line per plan: CPU model, inputs, neurons, executor workers, weight precision, schedule, block size and
+ * seconds separated by tabs. A missing file is an empty cache, malformed lines and those of older versions, which
+ * lack the workers and precision, are skipped.
+ */
+void Autotuner::load()
+{
+	std::ifstream file(cachePath);
+	std::string line;
+	while (std::getline(file, line))
+	{
+		auto modelEnd = line.find('\t');
+		if (modelEnd == std::string::npos || std::count(line.begin(), line.end(), '\t') != 7)
+		{
+			continue;
+		}
+		std::istringstream fields(line.substr(modelEnd + 1));
+		unsigned long inputsSize = 0, neuronsSize = 0, workers = 0, precision = 0, schedule = 0;
+		Plan plan;
+		if (!(fields >> inputsSize >> neuronsSize >> workers >> precision >> schedule >> plan.backwardBlockSize >> plan.seconds) ||
+			precision > Precision::BFloat16 || schedule > Layer::Parallel)
+		{
+			continue;
+		}
+		plan.schedule = (Layer::Schedule)schedule;
+		plans[line.substr(0, modelEnd) + "\t" + std::to_string(inputsSize) + "\t" + std::to_string(neuronsSize) + "\t" + std::to_string(workers) + "\t" +
+			std::to_string(precision)] = plan;
+	}
+};
+/*
+ */
+void Autotuner::save() const
+{
+	std::ofstream file(cachePath);
+	if (!file.is_open())
+	{
+		throw std::ios_base::failure("Error: Unable to open file for writing.");
+	}
+	for (auto &[planKey, plan] : plans)
+	{
+		file << planKey << "\t" << (unsigned long)plan.schedule << "\t" << plan.backwardBlockSize << "\t" << (double)plan.seconds << "\n";
+	}
+	if (!file)
+	{
+		throw std::ios_base::failure("Error: Writing to the file failed.");
+	}
+};
+/*
+ */
+const long double Autotuner::measure(NeuralNetwork &network, const std::vector<long double> &inputValues, const std::vector<long double> &targetValues)
+{
+	long double fastest = 0;
+	for (unsigned long repetition = 0; repetition < (std::max)(1ul, repetitions); repetition++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		network.feedforward(inputValues);
+		network.backpropagate(targetValues);
+		long double seconds = std::chrono::duration<long double>(std::chrono::steady_clock::now() - start).count();
+		fastest = repetition ? (std::min)(fastest, seconds) : seconds;
+	}
+	return fastest;
+};
+/*
+ * Applies and returns the plan of every layer, the input layer's and those of non-dense layers stay Automatic.
+ * Layers are timed one at a time within full passes while the other layers keep their current plans, and new
+ * plans are written to the cache file.
+ */
+const std::vector<Autotuner::Plan> Autotuner::tune(NeuralNetwork &network)
+{
+	auto layersSize = network.layers.size();
+	std::vector<Plan> layerPlans(layersSize);
+	if (layersSize < 2)
+	{
+		return layerPlans;
+	}
+	auto parameters = network.getParameters();
+	std::vector<long double> inputValues(network.layers[0].neurons.size());
+	std::vector<long double> targetValues(network.layers.back().neurons.size());
+	for (auto &value : inputValues)
+	{
+		value = Random::value<long double>(-1, 1);
+	}
+	for (auto &value : targetValues)
+	{
+		value = Random::value<long double>(0, 1);
+	}
+	auto workers = network.getExecutor().size();
+	std::vector<Layer::Schedule> schedules = {Layer::Serial};
+	if (workers > 1)
+	{
+		schedules.push_back(Layer::Parallel);
+	}
+	bool changed = false;
+	for (unsigned long layerIndex = 1; layerIndex < layersSize; layerIndex++)
+	{
+		auto &layer = network.layers[layerIndex];
+		if (layer.type != Layer::Dense)
+		{
+			continue;
+		}
+		auto inputsSize = network.layers[layerIndex - 1].neurons.size();
+		auto neuronsSize = layer.neurons.size();
+		auto &plan = layerPlans[layerIndex];
+		if (!find(inputsSize, neuronsSize, workers, network.weightPrecision, plan))
+		{
+			for (auto schedule : schedules)
+			{
+				for (auto blockSize : blockSizes)
+				{
+					// Blocks past the first one covering every input all run as a single block
+					if (!blockSize || (blockSize >= 2 * inputsSize && blockSize != blockSizes.front()))
+					{
+						continue;
+					}
+					layer.schedule = schedule;
+					layer.backwardBlockSize = blockSize;
+					auto seconds = measure(network, inputValues, targetValues);
+					if (!plan.backwardBlockSize || seconds < plan.seconds)
+					{
+						plan = {schedule, blockSize, seconds};
+					}
+				}
+			}
+			plans[key(inputsSize, neuronsSize, workers, network.weightPrecision)] = plan;
+			changed = true;
+		}
+		layer.schedule = plan.schedule;
+		layer.backwardBlockSize = plan.backwardBlockSize;
+	}
+	network.setParameters(parameters);
+	if (changed)
+	{
+		save();
+	}
+	return layerPlans;
+};
+/*
+ */
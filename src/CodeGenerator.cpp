@@ -0,0 +1,182 @@
+/*
+ */
+#include <CodeGenerator.hpp>
+#include <Tracer.hpp>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+using namespace nnpp;
+/*
+ */
+static const std::string formatValue(const long double &value)
+{
+	std::ostringstream stream;
+	stream << std::setprecision(std::numeric_limits<long double>::max_digits10) << value;
+	auto text = stream.str();
+	if (text.find_first_of(".e") == std::string::npos)
+	{
+		text += ".0";
+	}
+	return text + "L";
+};
+/*
+ */
+static const std::string activationBody(const NeuralNetwork::ActivationType &activationType)
+{
+	switch (activationType)
+	{
+	case NeuralNetwork::Sigmoid:
+		return "return 1.0L / (1.0L + std::exp(-x));";
+	case NeuralNetwork::Linear:
+		return "return x;";
+	case NeuralNetwork::Tanh:
+		return "return std::tanh(x);";
+	case NeuralNetwork::Swish:
+		return "return x / (1.0L + std::exp(-x));";
+	}
+	throw std::runtime_error("Activation type is not supported by CodeGenerator");
+};
+/*
+ */
+static const std::string valueName(const unsigned long &layerIndex, const unsigned long &neuronIndex)
+{
+	if (layerIndex == 0)
+	{
+		return "input[" + std::to_string(neuronIndex) + "]";
+	}
+	return "layer" + std::to_string(layerIndex) + "_" + std::to_string(neuronIndex);
+};
+/*
+ */
+const std::string CodeGenerator::generateHeader(const NeuralNetwork &network, const std::string &name)
+{
+	auto lock = Tracer::lock((std::mutex&)network.mutex);
+	auto &layers = network.layers;
+	auto layersSize = layers.size();
+	if (layersSize < 2)
+	{
+		throw std::runtime_error("CodeGenerator requires at least an input and an output layer");
+	}
+	if (!network.isDense())
+	{
+		throw std::runtime_error("CodeGenerator supports dense layers only");
+	}
+	std::ostringstream header;
+	header << "/*\n * Generated by zeuron CodeGenerator. Topology:";
+	for (auto &layer : layers)
+	{
+		header << " " << layer.neurons.size();
+	}
+	if (network.weightPrecision != Precision::Extended)
+	{
+		header << "\n * Weights are the network's " << (network.weightPrecision == Precision::Half ? "half" : "bfloat16") <<
+			" values, accumulated in long double rather than float";
+	}
+	if (network.activationAccuracy != NeuralNetwork::Exact)
+	{
+		header << "\n * Activations are exact, the network uses approximated ones";
+	}
+	header << "\n */\n#pragma once\n#include <cmath>\n/*\n */\nnamespace " << name << "\n{\n";
+	header << "\tconstexpr unsigned long inputSize = " << layers.front().neurons.size() << ";\n";
+	header << "\tconstexpr unsigned long outputSize = " << layers.back().neurons.size() << ";\n";
+	for (unsigned long layerIndex = 1; layerIndex < layersSize; layerIndex++)
+	{
+		auto &neurons = layers[layerIndex].neurons;
+		auto neuronsSize = neurons.size();
+		auto previousNeuronsSize = layers[layerIndex - 1].neurons.size();
+		auto layerName = "layer" + std::to_string(layerIndex);
+		header << "\tconstexpr long double " << layerName << "Weights[" << neuronsSize << "][" << previousNeuronsSize << "] = {\n";
+		// Reduced precision layers serve their packed weights, any master weights only take the updates
+		auto packedWeights = network.weightPrecision != Precision::Extended ? layers[layerIndex].packedWeights.data() : 0;
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+		{
+			header << "\t\t{";
+			for (unsigned long weightIndex = 0; weightIndex < previousNeuronsSize; weightIndex++)
+			{
+				auto weight = packedWeights ? (long double)Precision::widen(packedWeights[neuronIndex * previousNeuronsSize + weightIndex], network.weightPrecision) :
+					neurons[neuronIndex].weights[weightIndex];
+				header << (weightIndex ? ", " : "") << formatValue(weight);
+			}
+			header << "},\n";
+		}
+		header << "\t};\n";
+		header << "\tconstexpr long double " << layerName << "Biases[" << neuronsSize << "] = {";
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+		{
+			header << (neuronIndex ? ", " : "") << formatValue(neurons[neuronIndex].bias);
+		}
+		header << "};\n";
+	}
+	header << "\tinline long double activation(const long double x)\n\t{\n\t\t" << activationBody(network.activationType) << "\n\t}\n";
+	header << "\tinline void infer(const long double *input, long double *output)\n\t{\n";
+	for (unsigned long layerIndex = 1; layerIndex < layersSize; layerIndex++)
+	{
+		auto neuronsSize = layers[layerIndex].neurons.size();
+		auto previousNeuronsSize = layers[layerIndex - 1].neurons.size();
+		auto layerName = "layer" + std::to_string(layerIndex);
+		// The softmax output layer keeps its logits, normalized once the whole layer is known
+		auto softmax = network.outputMode == NeuralNetwork::SoftmaxCrossEntropy && layerIndex == layersSize - 1;
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+		{
+			auto row = std::to_string(neuronIndex);
+			header << "\t\t" << (softmax ? "" : "const ") << "long double " << valueName(layerIndex, neuronIndex) << " = " << (softmax ? "((" : "activation((");
+			for (unsigned long weightIndex = 0; weightIndex < previousNeuronsSize; weightIndex++)
+			{
+				header << (weightIndex ? " + " : "") << layerName << "Weights[" << row << "][" << weightIndex << "] * " << valueName(layerIndex - 1, weightIndex);
+			}
+			header << ") + " << layerName << "Biases[" << row << "]);\n";
+		}
+	}
+	auto outputsSize = layers.back().neurons.size();
+	if (network.outputMode == NeuralNetwork::SoftmaxCrossEntropy)
+	{
+		header << "\t\tlong double maximum = " << valueName(layersSize - 1, 0) << ";\n";
+		for (unsigned long neuronIndex = 1; neuronIndex < outputsSize; neuronIndex++)
+		{
+			auto value = valueName(layersSize - 1, neuronIndex);
+			header << "\t\tmaximum = " << value << " > maximum ? " << value << " : maximum;\n";
+		}
+		header << "\t\tlong double sum = 0;\n";
+		for (unsigned long neuronIndex = 0; neuronIndex < outputsSize; neuronIndex++)
+		{
+			auto value = valueName(layersSize - 1, neuronIndex);
+			header << "\t\t" << value << " = std::exp(" << value << " - maximum);\n\t\tsum += " << value << ";\n";
+		}
+		for (unsigned long neuronIndex = 0; neuronIndex < outputsSize; neuronIndex++)
+		{
+			header << "\t\t" << valueName(layersSize - 1, neuronIndex) << " /= sum;\n";
+		}
+	}
+	for (unsigned long neuronIndex = 0; neuronIndex < outputsSize; neuronIndex++)
+	{
+		header << "\t\toutput[" << neuronIndex << "] = " << valueName(layersSize - 1, neuronIndex) << ";\n";
+	}
+	header << "\t}\n}\n/*\n */\n";
+	return header.str();
+};
+/*
+ */
+void CodeGenerator::writeHeader(const NeuralNetwork &network, const std::string &name, const std::string &filename)
+{
+	std::ofstream file(filename);
+	if (!file.is_open())
+	{
+		throw std::ios_base::failure("Error: Unable to open file for writing.");
+	}
+	file << generateHeader(network, name);
+	if (!file)
+	{
+		throw std::ios_base::failure("Error: Writing to the file failed.");
+	}
+};
+/*
+ */
+void CodeGenerator::writeHeader(const std::string &modelFilename, const std::string &name, const std::string &filename)
+{
+	auto network = NeuralNetwork::load(modelFilename);
+	writeHeader(*network, name, filename);
+};
+/*
+ */
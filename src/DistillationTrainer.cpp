@@ -0,0 +1,182 @@
+/*
+ */
+#include <DistillationTrainer.hpp>
+#include <PackedNetwork.hpp>
+#include <Random.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+using namespace nnpp;
+/*
+ */
+DistillationTrainer::DistillationTrainer(NeuralNetwork &teacher):
+	teacher(teacher)
+{
+};
+/*
+ * Dense networks are packed once and evaluated across the executor, anything else goes through predict
+ */
+const std::vector<std::vector<long double>> DistillationTrainer::predictAll(NeuralNetwork &network, const std::vector<std::vector<long double>> &inputs)
+{
+	auto inputsSize = inputs.size();
+	std::vector<std::vector<long double>> outputs(inputsSize);
+	if (!PackedNetwork::supports(network))
+	{
+		for (unsigned long sampleIndex = 0; sampleIndex < inputsSize; sampleIndex++)
+		{
+			outputs[sampleIndex] = network.predict(inputs[sampleIndex]);
+		}
+		return outputs;
+	}
+	PackedNetwork packed(network);
+	auto &pool = executor ? *executor : Executor::shared();
+	pool.parallelFor(0, inputsSize, 64, [&](unsigned long begin, unsigned long end)
+	{
+		for (unsigned long sampleIndex = begin; sampleIndex < end; sampleIndex++)
+		{
+			outputs[sampleIndex] = packed.predict(inputs[sampleIndex]);
+		}
+	});
+	return outputs;
+};
+/*
+ * Softmax outputs are sharpened or flattened as softmax(logits / temperature), which equals the normalized
+ * p^(1 / temperature) of the teacher's probabilities
+ */
+const Dataset DistillationTrainer::softTargets(const std::vector<std::vector<long double>> &inputs)
+{
+	Dataset dataset{inputs, predictAll(teacher, inputs)};
+	if (teacher.outputMode != NeuralNetwork::SoftmaxCrossEntropy || temperature == 1)
+	{
+		return dataset;
+	}
+	if (temperature <= 0)
+	{
+		throw std::runtime_error("DistillationTrainer: temperature must be positive");
+	}
+	for (auto &outputs : dataset.outputs)
+	{
+		long double sum = 0;
+		for (auto &output : outputs)
+		{
+			output = std::pow(output, 1 / temperature);
+			sum += output;
+		}
+		for (auto &output : outputs)
+		{
+			output /= sum;
+		}
+	}
+	return dataset;
+};
+/*
+ * Draws every input uniformly between the smallest and largest value it takes in the reference dataset
+ */
+const std::vector<std::vector<long double>> DistillationTrainer::syntheticInputs(const Dataset &reference, const unsigned long &count)
+{
+	if (reference.size() == 0)
+	{
+		throw std::runtime_error("DistillationTrainer: synthetic inputs need a non-empty reference dataset");
+	}
+	auto minimums = reference.inputs[0];
+	auto maximums = reference.inputs[0];
+	auto featuresSize = minimums.size();
+	for (auto &inputs : reference.inputs)
+	{
+		for (unsigned long featureIndex = 0; featureIndex < featuresSize; featureIndex++)
+		{
+			minimums[featureIndex] = (std::min)(minimums[featureIndex], inputs[featureIndex]);
+			maximums[featureIndex] = (std::max)(maximums[featureIndex], inputs[featureIndex]);
+		}
+	}
+	std::vector<std::vector<long double>> samples(count, std::vector<long double>(featuresSize));
+	for (auto &sample : samples)
+	{
+		for (unsigned long featureIndex = 0; featureIndex < featuresSize; featureIndex++)
+		{
+			sample[featureIndex] = minimums[featureIndex] == maximums[featureIndex] ? minimums[featureIndex] :
+				Random::value<long double>(minimums[featureIndex], maximums[featureIndex]);
+		}
+	}
+	return samples;
+};
+/*
+ * transferSet holds the soft targets from softTargets. With a tempered softmax the student learns logits z / T
+ * against the targets softmax(z_teacher / T); scaling its output layer by T afterwards serves softmax(z) at
+ * temperature 1, like the teacher
+ */
+std::shared_ptr<NeuralNetwork> DistillationTrainer::distill(const std::vector<unsigned long> &studentLayerSizes, const Dataset &transferSet)
+{
+	if (studentLayerSizes.size() < 2 || studentLayerSizes.front() != teacher.layers.front().neurons.size() ||
+		studentLayerSizes.back() != teacher.layers.back().neurons.size())
+	{
+		throw std::runtime_error("DistillationTrainer: the student must have the teacher's input and output sizes");
+	}
+	auto student = std::make_shared<NeuralNetwork>(studentLayerSizes, teacher.activationType);
+	student->outputMode = teacher.outputMode;
+	student->activationAccuracy = teacher.activationAccuracy;
+	student->learningRate = learningRate;
+	student->executor = executor;
+	auto transferSetSize = transferSet.size();
+	for (unsigned long epoch = 0; epoch < epochs; epoch++)
+	{
+		for (unsigned long sampleIndex = 0; sampleIndex < transferSetSize; sampleIndex++)
+		{
+			student->feedforward(transferSet.inputs[sampleIndex]);
+			student->backpropagate(transferSet.outputs[sampleIndex]);
+		}
+	}
+	if (student->outputMode == NeuralNetwork::SoftmaxCrossEntropy && temperature != 1)
+	{
+		auto &outputLayer = student->layers.back();
+		auto neuronsSize = outputLayer.neurons.size();
+		auto inputsSize = outputLayer.inputsSize();
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+		{
+			for (unsigned long inputIndex = 0; inputIndex < inputsSize; inputIndex++)
+			{
+				outputLayer.setWeight(neuronIndex, inputIndex, outputLayer.weight(neuronIndex, inputIndex) * temperature);
+			}
+			outputLayer.neurons[neuronIndex].bias *= temperature;
+		}
+		student->parametersVersion++;
+	}
+	return student;
+};
+/*
+ */
+const DistillationTrainer::Report DistillationTrainer::evaluate(NeuralNetwork &student, const std::vector<std::vector<long double>> &inputs)
+{
+	Report report;
+	report.teacherParameters = teacher.getParameters().size();
+	report.studentParameters = student.getParameters().size();
+	auto teacherOutputs = predictAll(teacher, inputs);
+	auto studentOutputs = predictAll(student, inputs);
+	auto inputsSize = inputs.size();
+	unsigned long agreements = 0;
+	unsigned long outputsCount = 0;
+	for (unsigned long sampleIndex = 0; sampleIndex < inputsSize; sampleIndex++)
+	{
+		auto &expected = teacherOutputs[sampleIndex];
+		auto &actual = studentOutputs[sampleIndex];
+		auto outputsSize = expected.size();
+		for (unsigned long outputIndex = 0; outputIndex < outputsSize; outputIndex++)
+		{
+			long double difference = actual[outputIndex] - expected[outputIndex];
+			report.meanSquaredError += difference * difference;
+		}
+		outputsCount += outputsSize;
+		if (outputsSize == 1)
+		{
+			agreements += (expected[0] >= 0.5) == (actual[0] >= 0.5);
+			continue;
+		}
+		agreements += std::max_element(expected.begin(), expected.end()) - expected.begin() ==
+			std::max_element(actual.begin(), actual.end()) - actual.begin();
+	}
+	report.meanSquaredError = outputsCount ? report.meanSquaredError / outputsCount : 0;
+	report.agreement = inputsSize ? (long double)agreements / inputsSize : 0;
+	return report;
+};
+/*
+ */
@@ -0,0 +1,134 @@
+/*
+ */
+#include <DistributedTrainer.hpp>
+#include <ByteStream.hpp>
+#include <Tracer.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+using namespace nnpp;
+/*
+ */
+DistributedTrainer::DistributedTrainer(NeuralNetwork &network, ParameterTransport &transport, const Mode &mode, const unsigned long &averagingInterval):
+	network(network),
+	transport(transport),
+	mode(mode),
+	averagingInterval((std::max)(1ul, averagingInterval))
+{
+	broadcastModel();
+};
+/*
+ */
+void DistributedTrainer::broadcastModel()
+{
+	NNPP_TRACE_SCOPE("broadcast model", "communication");
+	std::vector<char> bytes;
+	if (transport.rank() == 0)
+	{
+		auto byteStream = network.serialize();
+		bytes.assign(byteStream.bytes.get(), byteStream.bytes.get() + byteStream.bytesSize);
+	}
+	transport.broadcast(bytes);
+	if (transport.rank() == 0)
+	{
+		return;
+	}
+	std::shared_ptr<char> buffer(new char[bytes.size()], std::default_delete<char[]>());
+	std::memcpy(buffer.get(), bytes.data(), bytes.size());
+	bs::ByteStream byteStream(bytes.size(), buffer);
+	NeuralNetwork received(byteStream);
+	network.copyModel(received);
+};
+/*
+ * Replaces every replica's parameters with their mean over the ranks
+ */
+void DistributedTrainer::synchronize()
+{
+	NNPP_TRACE_SCOPE("synchronize", "communication");
+	auto parameters = network.getParameters();
+	transport.allReduce(parameters);
+	long double worldSize = transport.worldSize();
+	for (auto &parameter : parameters)
+	{
+		parameter /= worldSize;
+	}
+	network.setParameters(parameters);
+};
+/*
+ * Trains one epoch and returns the mean squared error over all ranks, measured before each batch's update
+ */
+const long double DistributedTrainer::train(const Dataset &dataset, const unsigned long &batchSize)
+{
+	if (batchSize == 0)
+	{
+		throw std::runtime_error("DistributedTrainer: batch size must be positive");
+	}
+	auto rank = transport.rank();
+	auto worldSize = transport.worldSize();
+	auto datasetSize = dataset.size();
+	auto globalBatchSize = batchSize * worldSize;
+	std::vector<long double> snapshot;
+	std::vector<long double> gradients;
+	std::vector<long double> totals = {0, 0};
+	unsigned long batchesCount = 0;
+	for (unsigned long batchBegin = 0; batchBegin < datasetSize; batchBegin += globalBatchSize)
+	{
+		if (mode == GradientAllReduce)
+		{
+			snapshot = network.getParameters();
+			gradients.assign(snapshot.size(), 0);
+		}
+		auto batchEnd = (std::min)(batchBegin + globalBatchSize, datasetSize);
+		for (unsigned long sampleIndex = batchBegin + rank; sampleIndex < batchEnd; sampleIndex += worldSize)
+		{
+			network.feedforward(dataset.inputs[sampleIndex]);
+			auto outputs = network.getOutputs();
+			auto &expectedOutputs = dataset.outputs[sampleIndex];
+			auto outputsSize = outputs.size();
+			for (unsigned long outputIndex = 0; outputIndex < outputsSize; outputIndex++)
+			{
+				long double difference = expectedOutputs[outputIndex] - outputs[outputIndex];
+				totals[0] += difference * difference;
+			}
+			totals[1] += outputsSize;
+			network.backpropagate(expectedOutputs);
+			if (mode == GradientAllReduce)
+			{
+				// Keep the sample's step, the learning rate times its negative gradient, and restore the snapshot
+				// so every sample of the batch is differentiated at the same parameters
+				auto parameters = network.getParameters();
+				auto parametersSize = parameters.size();
+				for (unsigned long parameterIndex = 0; parameterIndex < parametersSize; parameterIndex++)
+				{
+					gradients[parameterIndex] += parameters[parameterIndex] - snapshot[parameterIndex];
+				}
+				network.setParameters(snapshot);
+			}
+		}
+		batchesCount++;
+		if (mode == GradientAllReduce)
+		{
+			// Apply the mean step over the whole global batch
+			transport.allReduce(gradients);
+			long double samplesCount = batchEnd - batchBegin;
+			auto parametersSize = snapshot.size();
+			for (unsigned long parameterIndex = 0; parameterIndex < parametersSize; parameterIndex++)
+			{
+				snapshot[parameterIndex] += gradients[parameterIndex] / samplesCount;
+			}
+			network.setParameters(snapshot);
+		}
+		else if (batchesCount % averagingInterval == 0)
+		{
+			synchronize();
+		}
+	}
+	if (mode == ModelAveraging && batchesCount % averagingInterval != 0)
+	{
+		synchronize();
+	}
+	transport.allReduce(totals);
+	return totals[1] > 0 ? totals[0] / totals[1] : 0;
+};
+/*
+ */
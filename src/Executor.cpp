@@ -0,0 +1,424 @@
+/*
+ */
+#include <Executor.hpp>
+#include <Numa.hpp>
+#include <Tracer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <utility>
+using namespace nnpp;
+/*
+ */
+static thread_local Executor *currentExecutor = 0;
+static thread_local long currentWorkerIndex = -1;
+static thread_local Executor::Priority currentPriority = Executor::Normal;
+// Cores all executors with their own workers may use together (0 for the hardware concurrency), those executors
+// and the cores reserved by threads outside them
+static std::mutex budgetMutex;
+static unsigned long budgetCores = 0;
+static std::vector<Executor *> budgetedExecutors;
+static unsigned long reservedCores = 0;
+/*
+ * Called with budgetMutex held whenever the budget, the reservations or the set of executors changes.
+ * Reservations are served first, then explicit sizes in construction order, and automatically sized executors
+ * split what is left evenly; an executor may end up with no active worker while the budget is exhausted
+ */
+static void rebalance()
+{
+	auto remaining = budgetCores ? budgetCores : (std::max)(1u, std::thread::hardware_concurrency());
+	remaining -= (std::min)(remaining, reservedCores);
+	unsigned long automaticCount = 0;
+	for (auto executor : budgetedExecutors)
+	{
+		if (executor->requestedWorkers)
+		{
+			executor->activeWorkers = (std::min)(executor->requestedWorkers, remaining);
+			remaining -= executor->activeWorkers;
+		}
+		else
+		{
+			automaticCount++;
+		}
+	}
+	unsigned long automaticIndex = 0;
+	auto automaticShare = automaticCount ? remaining / automaticCount : 0;
+	auto automaticExtra = automaticCount ? remaining % automaticCount : 0;
+	for (auto executor : budgetedExecutors)
+	{
+		if (!executor->requestedWorkers)
+		{
+			auto share = automaticShare + (automaticIndex++ < automaticExtra ? 1 : 0);
+			executor->activeWorkers = (std::min)(share, (unsigned long)executor->workers.size());
+		}
+		{
+			// Taking the mutex orders this notify after a worker's predicate check, so the wakeup cannot be lost
+			std::lock_guard<std::mutex> lock(executor->mutex);
+		}
+		executor->condition.notify_all();
+		executor->parking.notify_all();
+	}
+};
+/*
+ */
+Executor::CoreReservation::CoreReservation(const unsigned long &cores):
+	cores(cores)
+{
+	std::lock_guard<std::mutex> lock(budgetMutex);
+	reservedCores += cores;
+	rebalance();
+};
+/*
+ */
+Executor::CoreReservation::~CoreReservation()
+{
+	std::lock_guard<std::mutex> lock(budgetMutex);
+	reservedCores -= cores;
+	rebalance();
+};
+/*
+ * An explicit numberOfThreads starts that many workers, 0 starts one per core the budget allows. Either way only
+ * the workers the core budget grants at the moment are active, the others stay parked
+ */
+Executor::Executor(const unsigned long &numberOfThreads, const std::vector<unsigned long> &cpus):
+	cpus(cpus),
+	requestedWorkers(numberOfThreads)
+{
+	std::lock_guard<std::mutex> lock(budgetMutex);
+	unsigned long threadCount = numberOfThreads;
+	if (threadCount == 0)
+	{
+		threadCount = (std::max)((unsigned long)(std::max)(1u, std::thread::hardware_concurrency()), budgetCores);
+	}
+	for (unsigned long threadIndex = 0; threadIndex < threadCount; threadIndex++)
+	{
+		queues.push_back(std::make_unique<WorkerQueue>());
+	}
+	for (unsigned long threadIndex = 0; threadIndex < threadCount; threadIndex++)
+	{
+		workers.emplace_back(&Executor::workerLoop, this, threadIndex);
+	}
+	budgetedExecutors.push_back(this);
+	rebalance();
+};
+/*
+ */
+Executor::Executor(HostPool &hostPool):
+	hostPool(&hostPool)
+{
+	queues.push_back(std::make_unique<WorkerQueue>());
+};
+/*
+ */
+Executor::~Executor()
+{
+	if (!hostPool)
+	{
+		std::lock_guard<std::mutex> lock(budgetMutex);
+		budgetedExecutors.erase(std::find(budgetedExecutors.begin(), budgetedExecutors.end(), this));
+		rebalance();
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	condition.notify_all();
+	parking.notify_all();
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
+	while (hostRunners > 0)
+	{
+		if (!tryRunOne())
+		{
+			std::this_thread::yield();
+		}
+	}
+	// Tasks left queued while no worker was active
+	while (tryRunOne())
+	{
+	}
+};
+/*
+ */
+void Executor::submit(Task task, const Priority &priority)
+{
+	auto level = priority == Inherit ? currentPriority : priority;
+	unsigned long queueIndex = currentExecutor == this ? currentWorkerIndex : nextQueue++ % queues.size();
+	// Counted before it becomes visible so a thief can never decrement below zero
+	pendingTasks++;
+	{
+		auto &queue = *queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks[level].push_back(std::move(task));
+	}
+	if (hostPool)
+	{
+		// Every runner takes whichever task has the highest priority by the time it runs
+		hostRunners++;
+		hostPool->post([this]
+		{
+			tryRunOne();
+			hostRunners--;
+		});
+		return;
+	}
+	if (activeWorkers == 0)
+	{
+		// No core to spare, the submitting thread runs the task
+		tryRunOne();
+		return;
+	}
+	{
+		// Taking the mutex orders this notify after a worker's predicate check, so the wakeup cannot be lost
+		std::lock_guard<std::mutex> lock(mutex);
+	}
+	condition.notify_one();
+};
+/*
+ */
+const bool Executor::takeTask(const unsigned long &queueIndex, const Priority &priority, Task &task)
+{
+	auto &queue = *queues[queueIndex];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	auto &tasks = queue.tasks[priority];
+	if (tasks.empty())
+	{
+		return false;
+	}
+	if ((long)queueIndex == currentWorkerIndex && currentExecutor == this)
+	{
+		task = std::move(tasks.back());
+		tasks.pop_back();
+	}
+	else
+	{
+		task = std::move(tasks.front());
+		tasks.pop_front();
+	}
+	pendingTasks--;
+	return true;
+};
+/*
+ */
+const bool Executor::tryRunOne()
+{
+	auto queuesSize = queues.size();
+	unsigned long firstQueue = currentExecutor == this ? currentWorkerIndex : nextQueue.load() % queuesSize;
+	Task task;
+	for (unsigned long priority = 0; priority < prioritiesCount; priority++)
+	{
+		for (unsigned long offset = 0; offset < queuesSize; offset++)
+		{
+			if (takeTask((firstQueue + offset) % queuesSize, (Priority)priority, task))
+			{
+				auto previousPriority = currentPriority;
+				currentPriority = (Priority)priority;
+				try
+				{
+					NNPP_TRACE_SCOPE(priority == High ? "high priority task" : "task", "executor");
+					task();
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(exceptionMutex);
+					if (!taskException)
+					{
+						taskException = std::current_exception();
+					}
+				}
+				currentPriority = previousPriority;
+				return true;
+			}
+		}
+	}
+	return false;
+};
+/*
+ * Blocks until remaining reaches zero, running queued tasks in the meantime so that waiting from inside a task
+ * cannot deadlock the pool. Whoever brings remaining to zero must call notifyCompletion.
+ */
+void Executor::wait(const std::atomic<unsigned long> &remaining)
+{
+	while (remaining > 0)
+	{
+		if (tryRunOne())
+		{
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(mutex);
+		completion.wait_for(lock, std::chrono::milliseconds(1), [&] { return remaining == 0 || pendingTasks > 0; });
+	}
+};
+/*
+ */
+void Executor::notifyCompletion()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+	}
+	completion.notify_all();
+};
+/*
+ * Returns the first exception thrown by a submitted task since the last call, null if none
+ */
+std::exception_ptr Executor::takeTaskException()
+{
+	std::lock_guard<std::mutex> lock(exceptionMutex);
+	return std::exchange(taskException, nullptr);
+};
+/*
+ * Splits [begin, end) into at most size() + 1 chunks of at least grainSize and runs them on the calling thread and
+ * the workers. Chunks are claimed from a shared counter and the caller only waits for chunks that are already
+ * running, never for queued tasks, so it is safe to call while holding a lock another task may need.
+ */
+void Executor::parallelFor(const unsigned long &begin, const unsigned long &end, const unsigned long &grainSize, const std::function<void(unsigned long, unsigned long)> &function)
+{
+	if (end <= begin)
+	{
+		return;
+	}
+	auto rangeSize = end - begin;
+	auto chunksCount = (std::min)((rangeSize + (std::max)(1ul, grainSize) - 1) / (std::max)(1ul, grainSize), size() + 1);
+	if (chunksCount <= 1)
+	{
+		function(begin, end);
+		return;
+	}
+	struct State
+	{
+		std::atomic<unsigned long> nextChunk = 0;
+		std::atomic<unsigned long> finishedChunks = 0;
+		unsigned long chunksCount = 0;
+		unsigned long begin = 0;
+		unsigned long rangeSize = 0;
+		const std::function<void(unsigned long, unsigned long)> *function = 0;
+		std::mutex mutex;
+		std::condition_variable finished;
+		std::exception_ptr exception;
+		void run()
+		{
+			unsigned long chunk;
+			// function is only dereferenced after claiming a chunk, while parallelFor is still waiting
+			while ((chunk = nextChunk++) < chunksCount)
+			{
+				try
+				{
+					(*function)(begin + rangeSize * chunk / chunksCount, begin + rangeSize * (chunk + 1) / chunksCount);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if (!exception)
+					{
+						exception = std::current_exception();
+					}
+				}
+				if (++finishedChunks == chunksCount)
+				{
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+					}
+					finished.notify_all();
+				}
+			}
+		};
+	};
+	auto state = std::make_shared<State>();
+	state->chunksCount = chunksCount;
+	state->begin = begin;
+	state->rangeSize = rangeSize;
+	state->function = &function;
+	for (unsigned long helperIndex = 1; helperIndex < chunksCount; helperIndex++)
+	{
+		submit([state] { state->run(); });
+	}
+	state->run();
+	// The remaining chunks are already running, spin briefly before sleeping
+	for (unsigned long spin = 0; spin < 64 && state->finishedChunks < chunksCount; spin++)
+	{
+		std::this_thread::yield();
+	}
+	{
+		std::unique_lock<std::mutex> lock(state->mutex);
+		state->finished.wait(lock, [&] { return state->finishedChunks == chunksCount; });
+	}
+	if (state->exception)
+	{
+		std::rethrow_exception(state->exception);
+	}
+};
+/*
+ */
+const unsigned long Executor::size() const
+{
+	return hostPool ? hostPool->concurrency() : activeWorkers.load();
+};
+/*
+ */
+const long Executor::currentWorker() const
+{
+	return currentExecutor == this ? currentWorkerIndex : -1;
+};
+/*
+ */
+Executor &Executor::shared()
+{
+	static Executor executor;
+	return executor;
+};
+/*
+ * Rebalances the live executors too, 0 restores the hardware concurrency. Automatically sized executors cannot
+ * grow past the workers they started with.
+ */
+void Executor::setCoreBudget(const unsigned long &cores)
+{
+	std::lock_guard<std::mutex> lock(budgetMutex);
+	budgetCores = cores;
+	rebalance();
+};
+/*
+ */
+const unsigned long Executor::coreBudget()
+{
+	std::lock_guard<std::mutex> lock(budgetMutex);
+	return budgetCores ? budgetCores : (std::max)(1u, std::thread::hardware_concurrency());
+};
+/*
+ */
+void Executor::workerLoop(const unsigned long workerIndex)
+{
+	currentExecutor = this;
+	currentWorkerIndex = workerIndex;
+	if (!cpus.empty())
+	{
+		Numa::pinThreadToCpus({cpus[workerIndex % cpus.size()]});
+	}
+	while (true)
+	{
+		if (workerIndex >= activeWorkers)
+		{
+			// Parked workers leave the queued tasks to the active ones and the destructor
+			std::unique_lock<std::mutex> lock(mutex);
+			parking.wait(lock, [&] { return stopping || workerIndex < activeWorkers; });
+			if (stopping)
+			{
+				return;
+			}
+			continue;
+		}
+		if (tryRunOne())
+		{
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [&] { return stopping || pendingTasks > 0 || workerIndex >= activeWorkers; });
+		if (stopping && pendingTasks == 0)
+		{
+			return;
+		}
+	}
+};
+/*
+ */
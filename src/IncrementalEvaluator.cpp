@@ -0,0 +1,137 @@
+/*
+ */
+#include <IncrementalEvaluator.hpp>
+#include <Tracer.hpp>
+#include <cmath>
+#include <stdexcept>
+using namespace nnpp;
+/*
+ */
+IncrementalEvaluator::IncrementalEvaluator(NeuralNetwork &network, const long double &epsilon, const unsigned long &refreshInterval):
+	network(network),
+	epsilon(epsilon),
+	refreshInterval(refreshInterval)
+{
+	if (!network.isDense())
+	{
+		throw std::runtime_error("IncrementalEvaluator supports dense layers only");
+	}
+	if (network.outputMode != NeuralNetwork::ActivationOutput)
+	{
+		throw std::runtime_error("IncrementalEvaluator does not support the softmax output");
+	}
+	if (network.weightPrecision != Precision::Extended)
+	{
+		throw std::runtime_error("IncrementalEvaluator supports Extended weight precision only");
+	}
+};
+/*
+ */
+void IncrementalEvaluator::reset()
+{
+	primed = false;
+};
+/*
+ */
+const std::vector<long double> &IncrementalEvaluator::outputs() const
+{
+	return activations.back();
+};
+/*
+ */
+void IncrementalEvaluator::evaluateFully(const std::vector<long double> &inputValues)
+{
+	auto layersSize = network.layers.size();
+	auto layersData = network.layers.data();
+	preActivations.resize(layersSize);
+	activations.resize(layersSize);
+	activations[0].assign(inputValues.begin(), inputValues.begin() + layersData[0].neurons.size());
+	for (unsigned long layerIndex = 1; layerIndex < layersSize; layerIndex++)
+	{
+		auto neuronsSize = layersData[layerIndex].neurons.size();
+		auto neuronsData = layersData[layerIndex].neurons.data();
+		auto &previousActivations = activations[layerIndex - 1];
+		auto previousSize = previousActivations.size();
+		auto previousData = previousActivations.data();
+		auto &layerPreActivations = preActivations[layerIndex];
+		auto &layerActivations = activations[layerIndex];
+		layerPreActivations.resize(neuronsSize);
+		layerActivations.resize(neuronsSize);
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+		{
+			auto weightsData = neuronsData[neuronIndex].weights.data();
+			long double inputValue = 0.0;
+			for (unsigned long n = 0; n < previousSize; n++)
+			{
+				inputValue += previousData[n] * weightsData[n];
+			}
+			layerPreActivations[neuronIndex] = inputValue + neuronsData[neuronIndex].bias;
+			layerActivations[neuronIndex] = network.activation(layerPreActivations[neuronIndex]);
+		}
+	}
+	parametersVersion = network.parametersVersion;
+	updatesSinceRefresh = 0;
+	primed = true;
+};
+/*
+ */
+const std::vector<long double> &IncrementalEvaluator::evaluate(const std::vector<long double> &inputValues)
+{
+	auto lock = Tracer::lock(network.mutex);
+	if (!primed || parametersVersion != network.parametersVersion || ++updatesSinceRefresh >= refreshInterval)
+	{
+		evaluateFully(inputValues);
+		return activations.back();
+	}
+	// Collect the inputs that changed since the previous call
+	changedIndices.clear();
+	changedDeltas.clear();
+	auto &inputActivations = activations[0];
+	auto inputsSize = inputActivations.size();
+	for (unsigned long inputIndex = 0; inputIndex < inputsSize; inputIndex++)
+	{
+		if (inputValues[inputIndex] != inputActivations[inputIndex])
+		{
+			changedIndices.push_back(inputIndex);
+			changedDeltas.push_back(inputValues[inputIndex] - inputActivations[inputIndex]);
+			inputActivations[inputIndex] = inputValues[inputIndex];
+		}
+	}
+	auto layersSize = network.layers.size();
+	auto layersData = network.layers.data();
+	for (unsigned long layerIndex = 1; layerIndex < layersSize && !changedIndices.empty(); layerIndex++)
+	{
+		auto neuronsSize = layersData[layerIndex].neurons.size();
+		auto neuronsData = layersData[layerIndex].neurons.data();
+		auto layerPreActivationsData = preActivations[layerIndex].data();
+		auto layerActivationsData = activations[layerIndex].data();
+		auto changedSize = changedIndices.size();
+		auto changedIndicesData = changedIndices.data();
+		auto changedDeltasData = changedDeltas.data();
+		nextChangedIndices.clear();
+		nextChangedDeltas.clear();
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+		{
+			auto weightsData = neuronsData[neuronIndex].weights.data();
+			long double delta = 0.0;
+			for (unsigned long changedIndex = 0; changedIndex < changedSize; changedIndex++)
+			{
+				delta += weightsData[changedIndicesData[changedIndex]] * changedDeltasData[changedIndex];
+			}
+			layerPreActivationsData[neuronIndex] += delta;
+			long double activation = network.activation(layerPreActivationsData[neuronIndex]);
+			// Changes within epsilon are not propagated; the cached activation keeps the value the next layer has seen
+			if (std::abs(activation - layerActivationsData[neuronIndex]) > epsilon)
+			{
+				nextChangedIndices.push_back(neuronIndex);
+				nextChangedDeltas.push_back(activation - layerActivationsData[neuronIndex]);
+				layerActivationsData[neuronIndex] = activation;
+			}
+		}
+		changedIndices.swap(nextChangedIndices);
+		changedDeltas.swap(nextChangedDeltas);
+	}
+	return activations.back();
+};
+/*
+ */
@@ -0,0 +1,160 @@
+/*
+ */
+#include <InferenceCache.hpp>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+using namespace nnpp;
+/*
+ */
+const double InferenceCache::Statistics::hitRate() const
+{
+	auto lookups = hits + misses;
+	return lookups ? (double)hits / lookups : 0.0;
+};
+/*
+ */
+InferenceCache::InferenceCache(NeuralNetwork &network, const unsigned long &capacity, const unsigned long &shardsCount, const long double &tolerance):
+	network(&network),
+	shardCapacity((std::max)(1ul, (capacity + shardsCount - 1) / (std::max)(1ul, shardsCount))),
+	tolerance(tolerance)
+{
+	for (unsigned long shardIndex = 0; shardIndex < (std::max)(1ul, shardsCount); shardIndex++)
+	{
+		shards.push_back(std::make_unique<Shard>());
+		shards.back()->parametersVersion = network.parametersVersion;
+	}
+};
+/*
+ */
+const std::vector<long double> InferenceCache::makeKey(const std::vector<long double> &inputValues) const
+{
+	if (tolerance <= 0)
+	{
+		return inputValues;
+	}
+	std::vector<long double> key(inputValues.size());
+	auto inputValuesSize = inputValues.size();
+	for (unsigned long inputIndex = 0; inputIndex < inputValuesSize; inputIndex++)
+	{
+		key[inputIndex] = std::round(inputValues[inputIndex] / tolerance);
+	}
+	return key;
+};
+/*
+ */
+const uint64_t InferenceCache::hashKey(const std::vector<long double> &key)
+{
+	// Only the value is hashed, never the padding bytes of long double
+	uint64_t hash = 0x9e3779b97f4a7c15ull ^ key.size();
+	for (auto &value : key)
+	{
+		double narrowed = (double)value;
+		hash ^= std::bit_cast<uint64_t>(narrowed == 0 ? 0.0 : narrowed);
+		hash *= 0xbf58476d1ce4e5b9ull;
+		hash ^= hash >> 31;
+	}
+	return hash;
+};
+/*
+ */
+const std::vector<long double> InferenceCache::predict(const std::vector<long double> &inputValues)
+{
+	auto key = makeKey(inputValues);
+	auto hash = hashKey(key);
+	auto &shard = *shards[hash % shards.size()];
+	unsigned long parametersVersion = network->parametersVersion;
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		if (shard.parametersVersion != parametersVersion)
+		{
+			if (!shard.entries.empty())
+			{
+				invalidations++;
+			}
+			shard.entries.clear();
+			shard.index.clear();
+			shard.parametersVersion = parametersVersion;
+		}
+		auto range = shard.index.equal_range(hash);
+		for (auto iterator = range.first; iterator != range.second; ++iterator)
+		{
+			if (iterator->second->key == key)
+			{
+				shard.entries.splice(shard.entries.begin(), shard.entries, iterator->second);
+				hits++;
+				return iterator->second->outputs;
+			}
+		}
+	}
+	misses++;
+	// Run the network outside the shard lock; the result is only kept if no update happened in between
+	auto outputs = network->predict(inputValues);
+	if (network->parametersVersion != parametersVersion)
+	{
+		return outputs;
+	}
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	if (shard.parametersVersion != parametersVersion)
+	{
+		return outputs;
+	}
+	auto range = shard.index.equal_range(hash);
+	for (auto iterator = range.first; iterator != range.second; ++iterator)
+	{
+		if (iterator->second->key == key)
+		{
+			return outputs;
+		}
+	}
+	shard.entries.push_front({hash, std::move(key), outputs});
+	shard.index.emplace(hash, shard.entries.begin());
+	if (shard.entries.size() > shardCapacity)
+	{
+		auto &oldest = shard.entries.back();
+		auto oldestRange = shard.index.equal_range(oldest.hash);
+		for (auto iterator = oldestRange.first; iterator != oldestRange.second; ++iterator)
+		{
+			if (&*iterator->second == &oldest)
+			{
+				shard.index.erase(iterator);
+				break;
+			}
+		}
+		shard.entries.pop_back();
+		evictions++;
+	}
+	return outputs;
+};
+/*
+ */
+void InferenceCache::setNetwork(NeuralNetwork &network)
+{
+	this->network = &network;
+	clear();
+};
+/*
+ */
+void InferenceCache::clear()
+{
+	for (auto &shard : shards)
+	{
+		std::lock_guard<std::mutex> lock(shard->mutex);
+		shard->entries.clear();
+		shard->index.clear();
+		shard->parametersVersion = network->parametersVersion;
+	}
+};
+/*
+ */
+const InferenceCache::Statistics InferenceCache::statistics() const
+{
+	Statistics statistics;
+	statistics.hits = hits;
+	statistics.misses = misses;
+	statistics.evictions = evictions;
+	statistics.invalidations = invalidations;
+	return statistics;
+};
+/*
+ */
@@ -1,6 +1,9 @@
 /*
 */
 #include <Layer.hpp>
+#include <Random.hpp>
+#include <cmath>
+#include <stdexcept>
 using namespace nnpp;
 /*
  */
@@ -16,7 +19,220 @@ Layer::Layer(const unsigned long &numberOfNeurons, const unsigned long &numberOf
 Layer &Layer::operator=(const Layer &other)
 {
 	neurons = other.neurons;
+	weightPrecision = other.weightPrecision;
+	packedWeights = other.packedWeights;
+	masterWeights = other.masterWeights;
+	type = other.type;
+	inputChannels = other.inputChannels;
+	inputHeight = other.inputHeight;
+	inputWidth = other.inputWidth;
+	outputChannels = other.outputChannels;
+	outputHeight = other.outputHeight;
+	outputWidth = other.outputWidth;
+	kernelHeight = other.kernelHeight;
+	kernelWidth = other.kernelWidth;
+	strideHeight = other.strideHeight;
+	strideWidth = other.strideWidth;
+	paddingHeight = other.paddingHeight;
+	paddingWidth = other.paddingWidth;
+	kernelWeights = other.kernelWeights;
+	kernelBiases = other.kernelBiases;
+	poolIndices = other.poolIndices;
+	schedule = other.schedule;
+	backwardBlockSize = other.backwardBlockSize;
 	return *this;
 };
+/*
+ */
+/*
+ * Moves a dense layer's weights to the storage of precision, converting them from the current one. The buffers
+ * left unused are released
+ */
+void Layer::pack(const Precision::Type &precision, const bool &keepMasterWeights)
+{
+	if (type != Dense || neurons.empty() ||
+		(precision == weightPrecision && (precision == Precision::Extended || keepMasterWeights == !masterWeights.empty())))
+	{
+		return;
+	}
+	auto neuronsSize = neurons.size();
+	auto weightsSize = inputsSize();
+	if (precision == Precision::Extended)
+	{
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; ++neuronIndex)
+		{
+			auto &weights = neurons[neuronIndex].weights;
+			weights.resize(weightsSize);
+			for (unsigned long weightIndex = 0; weightIndex < weightsSize; ++weightIndex)
+			{
+				weights[weightIndex] = weight(neuronIndex, weightIndex);
+			}
+		}
+		std::vector<uint16_t>().swap(packedWeights);
+		std::vector<float>().swap(masterWeights);
+		weightPrecision = precision;
+		return;
+	}
+	std::vector<float> values(neuronsSize * weightsSize);
+	for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; ++neuronIndex)
+	{
+		for (unsigned long weightIndex = 0; weightIndex < weightsSize; ++weightIndex)
+		{
+			values[neuronIndex * weightsSize + weightIndex] = (float)weight(neuronIndex, weightIndex);
+		}
+	}
+	packedWeights.resize(values.size());
+	auto valuesSize = values.size();
+	for (unsigned long valueIndex = 0; valueIndex < valuesSize; ++valueIndex)
+	{
+		packedWeights[valueIndex] = Precision::narrow(values[valueIndex], precision);
+	}
+	packedWeights.shrink_to_fit();
+	if (keepMasterWeights)
+	{
+		masterWeights = std::move(values);
+	}
+	else
+	{
+		std::vector<float>().swap(masterWeights);
+	}
+	for (auto &neuron : neurons)
+	{
+		std::vector<long double>().swap(neuron.weights);
+	}
+	weightPrecision = precision;
+};
+/*
+ * Reduced precision weights read the master copy when kept, so the value is the one training continues from
+ */
+const long double Layer::weight(const unsigned long &neuronIndex, const unsigned long &inputIndex) const
+{
+	if (weightPrecision == Precision::Extended)
+	{
+		return neurons[neuronIndex].weights[inputIndex];
+	}
+	auto weightIndex = neuronIndex * inputsSize() + inputIndex;
+	if (!masterWeights.empty())
+	{
+		return masterWeights[weightIndex];
+	}
+	return Precision::widen(packedWeights[weightIndex], weightPrecision);
+};
+/*
+ */
+void Layer::setWeight(const unsigned long &neuronIndex, const unsigned long &inputIndex, const long double &value)
+{
+	if (weightPrecision == Precision::Extended)
+	{
+		neurons[neuronIndex].weights[inputIndex] = value;
+		return;
+	}
+	auto weightIndex = neuronIndex * inputsSize() + inputIndex;
+	if (!masterWeights.empty())
+	{
+		masterWeights[weightIndex] = (float)value;
+	}
+	packedWeights[weightIndex] = Precision::narrow((float)value, weightPrecision);
+};
+/*
+ */
+const unsigned long Layer::inputsSize() const
+{
+	if (type != Dense)
+	{
+		return inputChannels * inputHeight * inputWidth;
+	}
+	if (neurons.empty())
+	{
+		return 0;
+	}
+	return weightPrecision == Precision::Extended ? neurons[0].weights.size() : packedWeights.size() / neurons.size();
+};
+/*
+ */
+void Layer::setGeometry(const Type &type, const unsigned long &inputChannels, const unsigned long &inputHeight, const unsigned long &inputWidth,
+	const unsigned long &outputChannels, const unsigned long &kernelHeight, const unsigned long &kernelWidth,
+	const unsigned long &strideHeight, const unsigned long &strideWidth, const unsigned long &paddingHeight, const unsigned long &paddingWidth)
+{
+	if (!inputChannels || !outputChannels || !kernelHeight || !kernelWidth || !strideHeight || !strideWidth ||
+		inputHeight + 2 * paddingHeight < kernelHeight || inputWidth + 2 * paddingWidth < kernelWidth)
+	{
+		throw std::runtime_error("Layer: kernel does not fit the padded input");
+	}
+	this->type = type;
+	this->inputChannels = inputChannels;
+	this->inputHeight = inputHeight;
+	this->inputWidth = inputWidth;
+	this->outputChannels = outputChannels;
+	this->kernelHeight = kernelHeight;
+	this->kernelWidth = kernelWidth;
+	this->strideHeight = strideHeight;
+	this->strideWidth = strideWidth;
+	this->paddingHeight = paddingHeight;
+	this->paddingWidth = paddingWidth;
+	outputHeight = (inputHeight + 2 * paddingHeight - kernelHeight) / strideHeight + 1;
+	outputWidth = (inputWidth + 2 * paddingWidth - kernelWidth) / strideWidth + 1;
+	auto outputsSize = outputChannels * outputHeight * outputWidth;
+	for (unsigned long neuronIndex = 0; neuronIndex < outputsSize; ++neuronIndex)
+	{
+		neurons.push_back({0});
+	}
+	if (type != Convolution)
+	{
+		return;
+	}
+	// Scaled by the fan-in, unit weights would saturate the activation once a kernel spans many inputs
+	auto kernelSize = inputChannels * kernelHeight * kernelWidth;
+	auto scale = 1 / std::sqrt((long double)kernelSize);
+	for (unsigned long weightIndex = 0; weightIndex < outputChannels * kernelSize; ++weightIndex)
+	{
+		kernelWeights.push_back(Random::value<long double>(-1, 1) * scale);
+	}
+	kernelBiases.assign(outputChannels, 0);
+};
+/*
+ */
+Layer Layer::convolution1D(const unsigned long &inputChannels, const unsigned long &inputLength, const unsigned long &outputChannels,
+	const unsigned long &kernelSize, const unsigned long &stride, const unsigned long &padding)
+{
+	Layer layer;
+	layer.setGeometry(Convolution, inputChannels, 1, inputLength, outputChannels, 1, kernelSize, 1, stride, 0, padding);
+	return layer;
+};
+/*
+ */
+Layer Layer::convolution2D(const unsigned long &inputChannels, const unsigned long &inputHeight, const unsigned long &inputWidth,
+	const unsigned long &outputChannels, const unsigned long &kernelHeight, const unsigned long &kernelWidth,
+	const unsigned long &stride, const unsigned long &padding)
+{
+	Layer layer;
+	layer.setGeometry(Convolution, inputChannels, inputHeight, inputWidth, outputChannels, kernelHeight, kernelWidth, stride, stride, padding, padding);
+	return layer;
+};
+/*
+ * A stride of 0 uses non-overlapping windows
+ */
+Layer Layer::pooling1D(const Type &type, const unsigned long &channels, const unsigned long &inputLength, const unsigned long &size, const unsigned long &stride)
+{
+	if (type != MaxPooling && type != AveragePooling)
+	{
+		throw std::runtime_error("Layer: pooling type must be MaxPooling or AveragePooling");
+	}
+	Layer layer;
+	layer.setGeometry(type, channels, 1, inputLength, channels, 1, size, 1, stride ? stride : size, 0, 0);
+	return layer;
+};
+/*
+ */
+Layer Layer::pooling2D(const Type &type, const unsigned long &channels, const unsigned long &inputHeight, const unsigned long &inputWidth, const unsigned long &size, const unsigned long &stride)
+{
+	if (type != MaxPooling && type != AveragePooling)
+	{
+		throw std::runtime_error("Layer: pooling type must be MaxPooling or AveragePooling");
+	}
+	Layer layer;
+	layer.setGeometry(type, channels, inputHeight, inputWidth, channels, size, size, stride ? stride : size, stride ? stride : size, 0, 0);
+	return layer;
+};
 /*
  */
\ No newline at end of file
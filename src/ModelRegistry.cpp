@@ -0,0 +1,186 @@
+/*
+ */
+#include <ModelRegistry.hpp>
+#include <Tracer.hpp>
+#include <chrono>
+using namespace nnpp;
+/*
+ */
+const double ModelRegistry::Statistics::hitRate() const
+{
+	auto lookups = hits + misses;
+	return lookups ? (double)hits / lookups : 0.0;
+};
+/*
+ */
+const double ModelRegistry::Statistics::meanLoadSeconds() const
+{
+	return loads ? loadSeconds / loads : 0.0;
+};
+/*
+ */
+ModelRegistry::ModelRegistry(const unsigned long &memoryBudget):
+	memoryBudget(memoryBudget)
+{
+};
+/*
+ * Prefetch tasks refer to the registry, wait for them
+ */
+ModelRegistry::~ModelRegistry()
+{
+	(executor ? *executor : Executor::shared()).wait(pendingPrefetches);
+};
+/*
+ * Called with the mutex held
+ */
+std::shared_ptr<std::promise<std::shared_ptr<NeuralNetwork>>> ModelRegistry::beginLoad(Entry &entry)
+{
+	auto promise = std::make_shared<std::promise<std::shared_ptr<NeuralNetwork>>>();
+	entry.loading = promise->get_future().share();
+	return promise;
+};
+/*
+ * Reads the file without holding the mutex, then makes the model resident and evicts down to the budget
+ */
+void ModelRegistry::load(const std::string &path, std::promise<std::shared_ptr<NeuralNetwork>> &promise)
+{
+	NNPP_TRACE_SCOPE("load model", "registry");
+	auto start = std::chrono::steady_clock::now();
+	std::shared_ptr<NeuralNetwork> network;
+	try
+	{
+		network = NeuralNetwork::load(path);
+	}
+	catch (...)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			entries[path].loading = {};
+		}
+		promise.set_exception(std::current_exception());
+		return;
+	}
+	auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto &entry = entries[path];
+		entry.network = network;
+		entry.loading = {};
+		entry.statistics.loads++;
+		entry.statistics.loadSeconds += seconds;
+		entry.statistics.bytes = network->memoryBytes();
+		entry.statistics.resident = true;
+		totalBytes += entry.statistics.bytes;
+		recency.push_front(path);
+		entry.recency = recency.begin();
+		enforceBudget();
+	}
+	promise.set_value(network);
+};
+/*
+ * Called with the mutex held
+ */
+void ModelRegistry::release(Entry &entry)
+{
+	recency.erase(entry.recency);
+	totalBytes -= entry.statistics.bytes;
+	entry.network.reset();
+	entry.statistics.resident = false;
+	entry.statistics.evictions++;
+};
+/*
+ * Called with the mutex held, the most recently used model is never evicted
+ */
+void ModelRegistry::enforceBudget()
+{
+	while (totalBytes > memoryBudget && recency.size() > 1)
+	{
+		release(entries[recency.back()]);
+	}
+};
+/*
+ */
+std::shared_ptr<NeuralNetwork> ModelRegistry::acquire(const std::string &path)
+{
+	std::shared_future<std::shared_ptr<NeuralNetwork>> loading;
+	std::shared_ptr<std::promise<std::shared_ptr<NeuralNetwork>>> promise;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto &entry = entries[path];
+		if (entry.network)
+		{
+			entry.statistics.hits++;
+			recency.splice(recency.begin(), recency, entry.recency);
+			return entry.network;
+		}
+		if (entry.loading.valid())
+		{
+			entry.statistics.hits++;
+		}
+		else
+		{
+			entry.statistics.misses++;
+			promise = beginLoad(entry);
+		}
+		loading = entry.loading;
+	}
+	if (promise)
+	{
+		load(path, *promise);
+	}
+	return loading.get();
+};
+/*
+ * Loads the model on the executor unless it is resident or already loading
+ */
+void ModelRegistry::prefetch(const std::string &path)
+{
+	std::shared_ptr<std::promise<std::shared_ptr<NeuralNetwork>>> promise;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto &entry = entries[path];
+		if (entry.network || entry.loading.valid())
+		{
+			return;
+		}
+		promise = beginLoad(entry);
+	}
+	auto &pool = executor ? *executor : Executor::shared();
+	pendingPrefetches++;
+	pool.submit([this, &pool, path, promise]
+	{
+		load(path, *promise);
+		if (--pendingPrefetches == 0)
+		{
+			pool.notifyCompletion();
+		}
+	}, Executor::Normal);
+};
+/*
+ */
+void ModelRegistry::evict(const std::string &path)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	auto iterator = entries.find(path);
+	if (iterator != entries.end() && iterator->second.network)
+	{
+		release(iterator->second);
+	}
+};
+/*
+ */
+const ModelRegistry::Statistics ModelRegistry::statistics(const std::string &path)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	auto iterator = entries.find(path);
+	return iterator == entries.end() ? Statistics() : iterator->second.statistics;
+};
+/*
+ */
+const unsigned long ModelRegistry::residentBytes()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return totalBytes;
+};
+/*
+ */
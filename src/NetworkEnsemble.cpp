@@ -0,0 +1,187 @@
+/*
+ */
+#include <NetworkEnsemble.hpp>
+#include <Activations.hpp>
+#include <Tracer.hpp>
+#include <algorithm>
+#include <stdexcept>
+using namespace nnpp;
+/*
+ */
+NetworkEnsemble::NetworkEnsemble(const std::vector<std::shared_ptr<NeuralNetwork>> &networks, const NeuralNetwork::ActivationAccuracy &activationAccuracy):
+	activationAccuracy(activationAccuracy)
+{
+	refresh(networks);
+};
+/*
+ */
+void NetworkEnsemble::refresh(const std::vector<std::shared_ptr<NeuralNetwork>> &networks)
+{
+	if (networks.empty())
+	{
+		throw std::runtime_error("NetworkEnsemble requires at least one network");
+	}
+	auto &first = *networks[0];
+	modelsSize = networks.size();
+	activationType = first.activationType;
+	layerSizes.clear();
+	for (auto &layer : first.layers)
+	{
+		layerSizes.push_back(layer.neurons.size());
+	}
+	auto layersSize = layerSizes.size();
+	layerWeights.assign(layersSize, {});
+	layerBiases.assign(layersSize, {});
+	for (unsigned long layerIndex = 1; layerIndex < layersSize; layerIndex++)
+	{
+		layerWeights[layerIndex].resize(layerSizes[layerIndex] * layerSizes[layerIndex - 1] * modelsSize);
+		layerBiases[layerIndex].resize(layerSizes[layerIndex] * modelsSize);
+	}
+	for (unsigned long modelIndex = 0; modelIndex < modelsSize; modelIndex++)
+	{
+		auto &network = *networks[modelIndex];
+		auto lock = Tracer::lock(network.mutex);
+		if (network.activationType != activationType || network.layers.size() != layersSize)
+		{
+			throw std::runtime_error("NetworkEnsemble requires networks with the same topology and activation");
+		}
+		if (!network.isDense())
+		{
+			throw std::runtime_error("NetworkEnsemble supports dense layers only");
+		}
+		if (network.outputMode != NeuralNetwork::ActivationOutput)
+		{
+			throw std::runtime_error("NetworkEnsemble does not support the softmax output");
+		}
+		for (unsigned long layerIndex = 1; layerIndex < layersSize; layerIndex++)
+		{
+			auto &neurons = network.layers[layerIndex].neurons;
+			auto neuronsSize = layerSizes[layerIndex];
+			auto previousSize = layerSizes[layerIndex - 1];
+			if (neurons.size() != neuronsSize || network.layers[layerIndex - 1].neurons.size() != previousSize)
+			{
+				throw std::runtime_error("NetworkEnsemble requires networks with the same topology and activation");
+			}
+			auto weightsData = layerWeights[layerIndex].data();
+			auto biasesData = layerBiases[layerIndex].data();
+			// Reduced precision models contribute the packed weights they predict with
+			auto &layer = network.layers[layerIndex];
+			for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+			{
+				for (unsigned long inputIndex = 0; inputIndex < previousSize; inputIndex++)
+				{
+					auto weightIndex = neuronIndex * previousSize + inputIndex;
+					weightsData[weightIndex * modelsSize + modelIndex] = layer.weightPrecision == Precision::Extended ? neurons[neuronIndex].weights[inputIndex] :
+						Precision::widen(layer.packedWeights[weightIndex], layer.weightPrecision);
+				}
+				biasesData[neuronIndex * modelsSize + modelIndex] = neurons[neuronIndex].bias;
+			}
+		}
+	}
+};
+/*
+ * outputValues receives outputsSize * modelsSize values, interleaved by model
+ */
+void NetworkEnsemble::predict(const long double *inputValues, double *outputValues, std::vector<double> &scratch) const
+{
+	auto layersSize = layerSizes.size();
+	auto maxLayerSize = *std::max_element(layerSizes.begin(), layerSizes.end());
+	scratch.resize(2 * maxLayerSize * modelsSize);
+	double *previousValues = scratch.data();
+	double *currentValues = previousValues + maxLayerSize * modelsSize;
+	// Every model sees the same input, broadcast it across the model lanes
+	for (unsigned long inputIndex = 0; inputIndex < layerSizes[0]; inputIndex++)
+	{
+		for (unsigned long modelIndex = 0; modelIndex < modelsSize; modelIndex++)
+		{
+			previousValues[inputIndex * modelsSize + modelIndex] = (double)inputValues[inputIndex];
+		}
+	}
+	for (unsigned long layerIndex = 1; layerIndex < layersSize; layerIndex++)
+	{
+		auto neuronsSize = layerSizes[layerIndex];
+		auto previousSize = layerSizes[layerIndex - 1];
+		auto weightsData = layerWeights[layerIndex].data();
+		auto biasesData = layerBiases[layerIndex].data();
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+		{
+			double *accumulators = currentValues + neuronIndex * modelsSize;
+			const double *biasRow = biasesData + neuronIndex * modelsSize;
+			for (unsigned long modelIndex = 0; modelIndex < modelsSize; modelIndex++)
+			{
+				accumulators[modelIndex] = 0.0;
+			}
+			const double *weightRow = weightsData + neuronIndex * previousSize * modelsSize;
+			for (unsigned long inputIndex = 0; inputIndex < previousSize; inputIndex++)
+			{
+				const double *weightLanes = weightRow + inputIndex * modelsSize;
+				const double *valueLanes = previousValues + inputIndex * modelsSize;
+				for (unsigned long modelIndex = 0; modelIndex < modelsSize; modelIndex++)
+				{
+					accumulators[modelIndex] += weightLanes[modelIndex] * valueLanes[modelIndex];
+				}
+			}
+			for (unsigned long modelIndex = 0; modelIndex < modelsSize; modelIndex++)
+			{
+				accumulators[modelIndex] += biasRow[modelIndex];
+			}
+		}
+		Activations::activate(activationType, activationAccuracy, currentValues, neuronsSize * modelsSize);
+		std::swap(previousValues, currentValues);
+	}
+	std::copy_n(previousValues, layerSizes.back() * modelsSize, outputValues);
+};
+/*
+ */
+const std::vector<std::vector<long double>> NetworkEnsemble::predict(const std::vector<long double> &inputValues) const
+{
+	thread_local std::vector<double> scratch;
+	auto outputsSize = layerSizes.back();
+	std::vector<double> outputValues(outputsSize * modelsSize);
+	predict(inputValues.data(), outputValues.data(), scratch);
+	std::vector<std::vector<long double>> modelOutputs(modelsSize, std::vector<long double>(outputsSize));
+	for (unsigned long outputIndex = 0; outputIndex < outputsSize; outputIndex++)
+	{
+		for (unsigned long modelIndex = 0; modelIndex < modelsSize; modelIndex++)
+		{
+			modelOutputs[modelIndex][outputIndex] = outputValues[outputIndex * modelsSize + modelIndex];
+		}
+	}
+	return modelOutputs;
+};
+/*
+ */
+const std::vector<long double> NetworkEnsemble::aggregate(const std::vector<long double> &inputValues, const Aggregation &aggregation) const
+{
+	thread_local std::vector<double> scratch;
+	auto outputsSize = layerSizes.back();
+	std::vector<double> outputValues(outputsSize * modelsSize);
+	predict(inputValues.data(), outputValues.data(), scratch);
+	std::vector<long double> aggregated(outputsSize);
+	for (unsigned long outputIndex = 0; outputIndex < outputsSize; outputIndex++)
+	{
+		auto lanesBegin = outputValues.begin() + outputIndex * modelsSize;
+		auto lanesEnd = lanesBegin + modelsSize;
+		if (aggregation == Median)
+		{
+			auto middle = lanesBegin + modelsSize / 2;
+			std::nth_element(lanesBegin, middle, lanesEnd);
+			long double median = *middle;
+			if (modelsSize % 2 == 0)
+			{
+				median = (median + *std::max_element(lanesBegin, middle)) / 2;
+			}
+			aggregated[outputIndex] = median;
+			continue;
+		}
+		long double sum = 0;
+		for (auto lane = lanesBegin; lane != lanesEnd; ++lane)
+		{
+			sum += *lane;
+		}
+		aggregated[outputIndex] = sum / modelsSize;
+	}
+	return aggregated;
+};
+/*
+ */
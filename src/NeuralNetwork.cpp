@@ -1,8 +1,14 @@
 /*
  */
 #include <NeuralNetwork.hpp>
+#include <Activations.hpp>
+#include <PackedNetwork.hpp>
 #include <Logger.hpp>
+#include <Tracer.hpp>
+#include <algorithm>
 #include <cmath>
+#include <fstream>
+#include <stdexcept>
 #include <ByteStream.hpp>
 using namespace nnpp;
 using namespace bs;
@@ -20,6 +26,26 @@ NeuralNetwork::NeuralNetwork(const std::vector<unsigned long> &layerSizes, const
 		layers.push_back({layerSizes[layerIndex], numberOfInputs});
 	}
 };
+/*
+ * Builds a network from prepared layers, e.g. convolution and pooling layers mixed with dense ones. The first
+ * layer only holds the inputs
+ */
+NeuralNetwork::NeuralNetwork(const std::vector<Layer> &layers, const ActivationType &activationType):
+	layers(layers),
+	activationType(activationType),
+	activation(std::get<0>(activationDerivatives[activationType])),
+	derivative(std::get<1>(activationDerivatives[activationType]))
+{
+	auto layersSize = layers.size();
+	for (unsigned long layerIndex = 1; layerIndex < layersSize; ++layerIndex)
+	{
+		if (layers[layerIndex].inputsSize() != layers[layerIndex - 1].neurons.size())
+		{
+			throw std::runtime_error("NeuralNetwork: layer " + std::to_string(layerIndex) + " expects " + std::to_string(layers[layerIndex].inputsSize()) +
+				" inputs but the previous layer has " + std::to_string(layers[layerIndex - 1].neurons.size()) + " neurons");
+		}
+	}
+};
 /*
  */
 template <>
@@ -87,25 +113,220 @@ BYTE_STREAM_READ_VECTOR(Layer);
 BYTE_STREAM_WRITE_VECTOR(Layer);
 /*
  */
+static void malformed(const std::string &reason)
+{
+	throw std::runtime_error("NeuralNetwork: malformed model, " + reason);
+};
+/*
+ * Checks what the kernels rely on: every dense neuron has one weight per previous neuron and convolution and
+ * pooling layers have a consistent geometry and kernels
+ */
+static void validateLayers(const std::vector<Layer> &layers)
+{
+	auto layersSize = layers.size();
+	if (layersSize == 0)
+	{
+		malformed("no layers");
+	}
+	if (layers[0].type != Layer::Dense || layers[0].neurons.empty())
+	{
+		malformed("invalid input layer");
+	}
+	for (unsigned long layerIndex = 1; layerIndex < layersSize; layerIndex++)
+	{
+		auto &layer = layers[layerIndex];
+		auto previousSize = layers[layerIndex - 1].neurons.size();
+		auto layerName = "layer " + std::to_string(layerIndex);
+		if (layer.neurons.empty())
+		{
+			malformed(layerName + " has no neurons");
+		}
+		if (layer.type == Layer::Dense && layer.weightPrecision != Precision::Extended)
+		{
+			auto weightsSize = layer.neurons.size() * previousSize;
+			if (layer.packedWeights.size() != weightsSize || (!layer.masterWeights.empty() && layer.masterWeights.size() != weightsSize))
+			{
+				malformed(layerName + " does not have one weight per previous neuron");
+			}
+			for (auto &neuron : layer.neurons)
+			{
+				if (!neuron.weights.empty())
+				{
+					malformed(layerName + " stores its weights twice");
+				}
+			}
+			continue;
+		}
+		if (layer.type == Layer::Dense)
+		{
+			for (auto &neuron : layer.neurons)
+			{
+				if (neuron.weights.size() != previousSize)
+				{
+					malformed(layerName + " does not have one weight per previous neuron");
+				}
+			}
+			continue;
+		}
+		if (layer.type > Layer::AveragePooling || !layer.inputChannels || !layer.outputChannels || !layer.kernelHeight || !layer.kernelWidth ||
+			!layer.strideHeight || !layer.strideWidth || layer.inputHeight + 2 * layer.paddingHeight < layer.kernelHeight ||
+			layer.inputWidth + 2 * layer.paddingWidth < layer.kernelWidth ||
+			layer.outputHeight != (layer.inputHeight + 2 * layer.paddingHeight - layer.kernelHeight) / layer.strideHeight + 1 ||
+			layer.outputWidth != (layer.inputWidth + 2 * layer.paddingWidth - layer.kernelWidth) / layer.strideWidth + 1 ||
+			layer.inputsSize() != previousSize || layer.outputChannels * layer.outputHeight * layer.outputWidth != layer.neurons.size())
+		{
+			malformed(layerName + " has an invalid geometry");
+		}
+		if (layer.type == Layer::Convolution ? layer.kernelWeights.size() != layer.outputChannels * layer.inputChannels * layer.kernelHeight * layer.kernelWidth ||
+			layer.kernelBiases.size() != layer.outputChannels : layer.outputChannels != layer.inputChannels)
+		{
+			malformed(layerName + " has invalid kernels");
+		}
+	}
+};
+/*
+ * Throws std::runtime_error unless the stream holds a complete model. Streams written by older versions end
+ * before one of the trailing field groups, which then keep their defaults
+ */
 NeuralNetwork::NeuralNetwork(bs::ByteStream& byteStream)
 {
+	NNPP_TRACE_SCOPE("deserialize", "io");
 	unsigned long bytesRead = 0;
-	if (!byteStream.read(learningRate, bytesRead, true))
+	auto bytesSize = byteStream.bytesSize;
+	unsigned int activationTypeInt = 0;
+	if (!byteStream.read(learningRate, bytesRead, true) || !byteStream.read(activationTypeInt, bytesRead, true))
 	{
-		return;
+		malformed("truncated header");
 	}
-	unsigned int activationTypeInt = 0;
-	if (!byteStream.read(activationTypeInt, bytesRead, true))
+	if (activationTypeInt > Swish)
 	{
-		return;
+		malformed("unknown activation");
 	}
 	activationType = (NeuralNetwork::ActivationType)activationTypeInt;
 	activation = std::get<0>(activationDerivatives[activationType]);
 	derivative = std::get<1>(activationDerivatives[activationType]);
-	if (!byteStream.read(layers, bytesRead, true))
+	try
 	{
-		return;
+		if (!byteStream.read(layers, bytesRead, true))
+		{
+			malformed("truncated layers");
+		}
+	}
+	catch (const std::length_error &)
+	{
+		malformed("invalid layer sizes");
+	}
+	catch (const std::bad_alloc &)
+	{
+		malformed("invalid layer sizes");
 	}
+	unsigned int weightPrecisionInt = 0;
+	unsigned int keepMasterWeightsInt = 1;
+	unsigned int activationAccuracyInt = 0;
+	unsigned int outputModeInt = 0;
+	auto ended = [&]
+	{
+		return bytesRead == bytesSize;
+	};
+	if (!ended())
+	{
+		if (!byteStream.read(weightPrecisionInt, bytesRead, true) || !byteStream.read(keepMasterWeightsInt, bytesRead, true))
+		{
+			malformed("truncated precision");
+		}
+	}
+	if (!ended())
+	{
+		if (!byteStream.read(activationAccuracyInt, bytesRead, true))
+		{
+			malformed("truncated activation accuracy");
+		}
+	}
+	for (unsigned long layerIndex = 0; layerIndex < layers.size(); layerIndex++)
+	{
+		auto &layer = layers[layerIndex];
+		unsigned int typeInt = 0;
+		if (layerIndex == 0 && ended())
+		{
+			break;
+		}
+		if (!byteStream.read(typeInt, bytesRead, true))
+		{
+			malformed("truncated layer types");
+		}
+		layer.type = (Layer::Type)typeInt;
+		if (layer.type == Layer::Dense)
+		{
+			continue;
+		}
+		unsigned long *geometry[] = {&layer.inputChannels, &layer.inputHeight, &layer.inputWidth, &layer.outputChannels, &layer.outputHeight, &layer.outputWidth,
+			&layer.kernelHeight, &layer.kernelWidth, &layer.strideHeight, &layer.strideWidth, &layer.paddingHeight, &layer.paddingWidth};
+		for (auto value : geometry)
+		{
+			unsigned int valueInt = 0;
+			if (!byteStream.read(valueInt, bytesRead, true))
+			{
+				malformed("truncated layer geometry");
+			}
+			*value = valueInt;
+		}
+		try
+		{
+			if (!byteStream.read(layer.kernelWeights, bytesRead, true) || !byteStream.read(layer.kernelBiases, bytesRead, true))
+			{
+				malformed("truncated kernels");
+			}
+		}
+		catch (const std::length_error &)
+		{
+			malformed("invalid kernel sizes");
+		}
+		catch (const std::bad_alloc &)
+		{
+			malformed("invalid kernel sizes");
+		}
+	}
+	if (!ended() && !byteStream.read(outputModeInt, bytesRead, true))
+	{
+		malformed("truncated output mode");
+	}
+	if (weightPrecisionInt > Precision::BFloat16 || activationAccuracyInt > Fast || outputModeInt > SoftmaxCrossEntropy)
+	{
+		malformed("unknown setting");
+	}
+	// Reduced precision weights, older versions stored them in the neurons as long double instead
+	for (unsigned long layerIndex = 1; weightPrecisionInt != Precision::Extended && !ended() && layerIndex < layers.size(); layerIndex++)
+	{
+		auto &layer = layers[layerIndex];
+		if (layer.type != Layer::Dense)
+		{
+			continue;
+		}
+		try
+		{
+			if (!byteStream.read(layer.packedWeights, bytesRead, true) || !byteStream.read(layer.masterWeights, bytesRead, true))
+			{
+				malformed("truncated reduced precision weights");
+			}
+		}
+		catch (const std::length_error &)
+		{
+			malformed("invalid reduced precision weights");
+		}
+		catch (const std::bad_alloc &)
+		{
+			malformed("invalid reduced precision weights");
+		}
+		if (layer.masterWeights.empty() == (bool)keepMasterWeightsInt)
+		{
+			malformed("master weights do not match the precision settings");
+		}
+		layer.weightPrecision = (Precision::Type)weightPrecisionInt;
+	}
+	validateLayers(layers);
+	activationAccuracy = (NeuralNetwork::ActivationAccuracy)activationAccuracyInt;
+	outputMode = (NeuralNetwork::OutputMode)outputModeInt;
+	setWeightPrecision((Precision::Type)weightPrecisionInt, keepMasterWeightsInt);
 };
 /*
  */
@@ -134,12 +355,23 @@ void NeuralNetwork::print()
  */
 void NeuralNetwork::feedforward(const std::vector<long double> &inputValues)
 {
-	std::lock_guard<std::mutex> lock(mutex);
+	NNPP_TRACE_SCOPE("feedforward", "network");
+	auto lock = Tracer::lock(mutex);
+	propagateForward(inputValues);
+};
+/*
+ */
+void NeuralNetwork::propagateForward(const std::vector<long double> &inputValues)
+{
 	// Assign input values to the first layer
 	auto layersSize = layers.size();
 	auto layersData = layers.data();
 	auto layer0NeuronsSize = layersData[0].neurons.size();
 	auto layer0NeuronsData = layersData[0].neurons.data();
+	if (inputValues.size() != layer0NeuronsSize)
+	{
+		throw std::runtime_error("NeuralNetwork: expected " + std::to_string(layer0NeuronsSize) + " input values, got " + std::to_string(inputValues.size()));
+	}
 	for (size_t i = 0; i < layer0NeuronsSize; ++i)
 	{
 		layer0NeuronsData[i].outputValue = inputValues[i];
@@ -147,85 +379,639 @@ void NeuralNetwork::feedforward(const std::vector<long double> &inputValues)
 	// Forward propagate through subsequent layers
 	for (size_t layerIndex = 1; layerIndex < layersSize; ++layerIndex)
 	{
+		NNPP_TRACE_SCOPE("forward layer", "kernel", layerIndex);
+		if (layersData[layerIndex].type == Layer::Convolution)
+		{
+			propagateConvolution(layerIndex);
+			continue;
+		}
+		if (layersData[layerIndex].type != Layer::Dense)
+		{
+			propagatePooling(layerIndex);
+			continue;
+		}
 		auto &prevLayer = layers[layerIndex - 1];
 		auto prevLayerNeuronsSize = prevLayer.neurons.size();
 		auto prevLayerNeuronsData = prevLayer.neurons.data();
-		for (auto &neuron : layersData[layerIndex].neurons)
+		if (weightPrecision != Precision::Extended)
 		{
-			neuron.inputValue = 0.0; // Reset the input value
-			auto neuronWeightsData = neuron.weights.data();
+			// Widen the reduced precision weights to float and accumulate in float
+			precisionScratch.resize(prevLayerNeuronsSize);
+			auto precisionScratchData = precisionScratch.data();
 			for (unsigned long n = 0; n < prevLayerNeuronsSize; ++n)
 			{
-				// Accumulate the weighted input values
-				neuron.inputValue += prevLayerNeuronsData[n].outputValue * neuronWeightsData[n];
+				precisionScratchData[n] = (float)prevLayerNeuronsData[n].outputValue;
 			}
-			// Add the bias and apply the activation function
-			neuron.inputValue += neuron.bias;
-			neuron.outputValue = activation(neuron.inputValue);
+			auto &layer = layersData[layerIndex];
+			auto neuronsData = layer.neurons.data();
+			auto packedWeightsData = layer.packedWeights.data();
+			forEachNeuron(layer, prevLayerNeuronsSize, [&](unsigned long neuronBegin, unsigned long neuronEnd)
+			{
+				for (unsigned long neuronIndex = neuronBegin; neuronIndex < neuronEnd; ++neuronIndex)
+				{
+					auto &neuron = neuronsData[neuronIndex];
+					neuron.inputValue = Precision::dot(packedWeightsData + neuronIndex * prevLayerNeuronsSize, precisionScratchData, prevLayerNeuronsSize, weightPrecision);
+					neuron.inputValue += neuron.bias;
+				}
+			});
+			activateLayer(layer);
+			continue;
 		}
+		auto neuronsData = layersData[layerIndex].neurons.data();
+		forEachNeuron(layersData[layerIndex], prevLayerNeuronsSize, [&](unsigned long neuronBegin, unsigned long neuronEnd)
+		{
+			for (unsigned long neuronIndex = neuronBegin; neuronIndex < neuronEnd; ++neuronIndex)
+			{
+				auto &neuron = neuronsData[neuronIndex];
+				neuron.inputValue = 0.0; // Reset the input value
+				auto neuronWeightsData = neuron.weights.data();
+				for (unsigned long n = 0; n < prevLayerNeuronsSize; ++n)
+				{
+					// Accumulate the weighted input values
+					neuron.inputValue += prevLayerNeuronsData[n].outputValue * neuronWeightsData[n];
+				}
+				// Add the bias
+				neuron.inputValue += neuron.bias;
+			}
+		});
+		activateLayer(layersData[layerIndex]);
+	}
+};
+/*
+ * Runs function over [0, neurons) of a layer, split by output neuron across the executor when the layer has at
+ * least parallelThreshold weights or is scheduled Parallel. Every neuron is still computed by a single thread in
+ * the same order, so the results do not depend on the split.
+ */
+void NeuralNetwork::forEachNeuron(const Layer &layer, const unsigned long &inputsSize, const std::function<void(unsigned long, unsigned long)> &function)
+{
+	auto neuronsSize = layer.neurons.size();
+	if (!isParallel(layer, neuronsSize * inputsSize))
+	{
+		function(0, neuronsSize);
+		return;
+	}
+	getExecutor().parallelFor(0, neuronsSize, parallelGrainSize / (std::max)(1ul, inputsSize), function);
+};
+/*
+ */
+const bool NeuralNetwork::isParallel(const Layer &layer, const unsigned long &weightsSize) const
+{
+	if (layer.schedule != Layer::Automatic)
+	{
+		return layer.schedule == Layer::Parallel;
+	}
+	return weightsSize >= parallelThreshold;
+};
+/*
+ */
+void NeuralNetwork::activateLayer(Layer &layer)
+{
+	auto neuronsSize = layer.neurons.size();
+	auto neuronsData = layer.neurons.data();
+	if (outputMode == SoftmaxCrossEntropy && &layer == &layers.back())
+	{
+		activateSoftmax(layer);
+		return;
+	}
+	if (activationAccuracy == Exact)
+	{
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; ++neuronIndex)
+		{
+			neuronsData[neuronIndex].outputValue = activation(neuronsData[neuronIndex].inputValue);
+		}
+		return;
+	}
+	// Approximate activations run over the whole layer at once in double precision
+	activationScratch.resize(neuronsSize);
+	auto activationScratchData = activationScratch.data();
+	for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; ++neuronIndex)
+	{
+		activationScratchData[neuronIndex] = (double)neuronsData[neuronIndex].inputValue;
+	}
+	Activations::activate(activationType, activationAccuracy, activationScratchData, neuronsSize);
+	for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; ++neuronIndex)
+	{
+		neuronsData[neuronIndex].outputValue = activationScratchData[neuronIndex];
+	}
+};
+/*
+ */
+void NeuralNetwork::activateSoftmax(Layer &layer)
+{
+	auto neuronsSize = layer.neurons.size();
+	auto neuronsData = layer.neurons.data();
+	if (activationAccuracy != Exact)
+	{
+		activationScratch.resize(neuronsSize);
+		auto activationScratchData = activationScratch.data();
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; ++neuronIndex)
+		{
+			activationScratchData[neuronIndex] = (double)neuronsData[neuronIndex].inputValue;
+		}
+		Activations::softmax(activationAccuracy, activationScratchData, neuronsSize);
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; ++neuronIndex)
+		{
+			neuronsData[neuronIndex].outputValue = activationScratchData[neuronIndex];
+		}
+		return;
+	}
+	valuesScratch.resize(neuronsSize);
+	auto valuesScratchData = valuesScratch.data();
+	for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; ++neuronIndex)
+	{
+		valuesScratchData[neuronIndex] = neuronsData[neuronIndex].inputValue;
+	}
+	Activations::softmax(Exact, valuesScratchData, neuronsSize);
+	for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; ++neuronIndex)
+	{
+		neuronsData[neuronIndex].outputValue = valuesScratchData[neuronIndex];
+	}
+};
+/*
+ * Sets gradient = error * derivative(outputValue) for neurons [begin, end). The approximate derivatives use
+ * activationScratch at the same indices, so disjoint ranges may run concurrently.
+ */
+template <typename T>
+static void assignGradients(NeuralNetwork &network, Layer &layer, const T *errorData, const unsigned long &begin, const unsigned long &end)
+{
+	auto neuronsData = layer.neurons.data();
+	// Pooling layers pass their inputs through without an activation
+	if (layer.type == Layer::MaxPooling || layer.type == Layer::AveragePooling)
+	{
+		for (unsigned long neuronIndex = begin; neuronIndex < end; ++neuronIndex)
+		{
+			neuronsData[neuronIndex].gradient = errorData[neuronIndex];
+		}
+		return;
+	}
+	if (network.activationAccuracy == NeuralNetwork::Exact)
+	{
+		for (unsigned long neuronIndex = begin; neuronIndex < end; ++neuronIndex)
+		{
+			neuronsData[neuronIndex].gradient = errorData[neuronIndex] * network.derivative(neuronsData[neuronIndex].outputValue);
+		}
+		return;
+	}
+	auto derivativesData = network.activationScratch.data();
+	for (unsigned long neuronIndex = begin; neuronIndex < end; ++neuronIndex)
+	{
+		derivativesData[neuronIndex] = (double)neuronsData[neuronIndex].outputValue;
+	}
+	Activations::differentiate(network.activationType, network.activationAccuracy, derivativesData + begin, end - begin);
+	for (unsigned long neuronIndex = begin; neuronIndex < end; ++neuronIndex)
+	{
+		neuronsData[neuronIndex].gradient = errorData[neuronIndex] * derivativesData[neuronIndex];
 	}
 };
 /*
  */
 void NeuralNetwork::backpropagate(const std::vector<long double> &targetValues)
 {
-	std::lock_guard<std::mutex> lock(mutex);
+	NNPP_TRACE_SCOPE("backpropagate", "network");
+	auto lock = Tracer::lock(mutex);
 	// Calculate gradients for the output layer
 	Layer &outputLayer = layers.back();
 	auto outputLayerNeuronsSize = outputLayer.neurons.size();
 	auto outputLayerNeuronsData = outputLayer.neurons.data();
 	auto targetValuesData = targetValues.data();
-	for (size_t i = 0; i < outputLayerNeuronsSize; ++i)
+	errorScratch.resize(outputLayerNeuronsSize);
+	activationScratch.resize(outputLayerNeuronsSize);
+	auto errorScratchData = errorScratch.data();
+	if (outputMode == SoftmaxCrossEntropy)
 	{
-		long double delta = targetValuesData[i] - outputLayerNeuronsData[i].outputValue;
-		outputLayerNeuronsData[i].gradient = delta * derivative(outputLayerNeuronsData[i].outputValue);
+		// Softmax and cross-entropy fused: the gradient is the error itself, no derivative needed
+		for (size_t i = 0; i < outputLayerNeuronsSize; ++i)
+		{
+			outputLayerNeuronsData[i].gradient = targetValuesData[i] - outputLayerNeuronsData[i].outputValue;
+		}
 	}
-
-	// Calculate gradients for the hidden layers (in reverse order)
-	auto layersSize = layers.size();
-	auto layersData = layers.data();
-	for (size_t layerIndex = layersSize - 2; layerIndex > 0; --layerIndex)
-	{
-		Layer &hiddenLayer = layersData[layerIndex];
-		Layer &nextLayer = layersData[layerIndex + 1];
-		auto hiddenLayerNeuronsSize = hiddenLayer.neurons.size();
-		auto hiddenLayerNeuronsData = hiddenLayer.neurons.data();
-		auto nextLayerNeuronsSize = nextLayer.neurons.size();
-		auto nextLayerNeuronsData = nextLayer.neurons.data();
-		for (size_t neuronIndex = 0; neuronIndex < hiddenLayerNeuronsSize; ++neuronIndex)
-		{
-			long double error = 0.0;
-			for (size_t nextNeuronIndex = 0; nextNeuronIndex < nextLayerNeuronsSize; ++nextNeuronIndex)
-			{
-				error += nextLayerNeuronsData[nextNeuronIndex].weights[neuronIndex] * nextLayerNeuronsData[nextNeuronIndex].gradient;
-			}
-			hiddenLayerNeuronsData[neuronIndex].gradient = error * derivative(hiddenLayerNeuronsData[neuronIndex].outputValue);
+	else
+	{
+		for (size_t i = 0; i < outputLayerNeuronsSize; ++i)
+		{
+			errorScratchData[i] = targetValuesData[i] - outputLayerNeuronsData[i].outputValue;
 		}
+		assignGradients(*this, outputLayer, errorScratchData, 0, outputLayerNeuronsSize);
 	}
 
-	// Update weights and biases for all layers (except input layer)
-	for (size_t layerIndex = 1; layerIndex < layersSize; ++layerIndex)
+	// Walk the layers in reverse order. A single pass over each layer's weight rows accumulates the previous
+	// layer's error with the old weights (a transposed matrix-vector product), applies the weight update in
+	// place and finishes the previous layer's gradients, one block of columns at a time so the error and input
+	// blocks stay in cache
+	auto layersSize = layers.size();
+	auto layersData = layers.data();
+	for (size_t layerIndex = layersSize - 1; layerIndex > 0; --layerIndex)
 	{
+		NNPP_TRACE_SCOPE("backward layer", "kernel", layerIndex);
 		Layer &layer = layersData[layerIndex];
+		if (layer.type == Layer::Convolution)
+		{
+			backpropagateConvolution(layerIndex);
+			continue;
+		}
+		if (layer.type != Layer::Dense)
+		{
+			backpropagatePooling(layerIndex);
+			continue;
+		}
 		Layer &prevLayer = layersData[layerIndex - 1];
+		auto prevLayerNeuronsSize = prevLayer.neurons.size();
 		auto prevLayerNeuronsData = prevLayer.neurons.data();
-		for (Neuron &neuron : layer.neurons)
+		valuesScratch.resize(prevLayerNeuronsSize);
+		errorScratch.resize(prevLayerNeuronsSize);
+		precisionScratch.resize(prevLayerNeuronsSize);
+		activationScratch.resize(prevLayerNeuronsSize);
+		auto valuesScratchData = valuesScratch.data();
+		for (size_t neuronIndex = 0; neuronIndex < prevLayerNeuronsSize; ++neuronIndex)
 		{
-			auto weightsSize = neuron.weights.size();
-			auto neuronWeightsData = neuron.weights.data();
-			for (size_t w = 0; w < weightsSize; ++w)
+			valuesScratchData[neuronIndex] = prevLayerNeuronsData[neuronIndex].outputValue;
+		}
+		// Column blocks touch disjoint weights and errors, so wide layers split them across the executor
+		auto neuronsSize = layer.neurons.size();
+		auto blockSize = layer.backwardBlockSize ? layer.backwardBlockSize : backwardBlockSize;
+		auto blocksSize = (prevLayerNeuronsSize + blockSize - 1) / blockSize;
+		auto runBlocks = [&](unsigned long blockBegin, unsigned long blockEnd)
+		{
+			for (unsigned long blockIndex = blockBegin; blockIndex < blockEnd; ++blockIndex)
 			{
-				neuronWeightsData[w] += learningRate * neuron.gradient * prevLayerNeuronsData[w].outputValue;
+				auto columnBegin = blockIndex * blockSize;
+				backpropagateBlock(layerIndex, columnBegin, (std::min)(columnBegin + blockSize, prevLayerNeuronsSize));
 			}
+		};
+		if (blocksSize > 1 && isParallel(layer, neuronsSize * prevLayerNeuronsSize))
+		{
+			getExecutor().parallelFor(0, blocksSize, parallelGrainSize / (std::max)(1ul, neuronsSize * blockSize), runBlocks);
+		}
+		else
+		{
+			runBlocks(0, blocksSize);
+		}
+		for (Neuron &neuron : layer.neurons)
+		{
 			neuron.bias += learningRate * neuron.gradient;
 		}
 	}
+	parametersVersion++;
+};
+/*
+ */
+void NeuralNetwork::backpropagateBlock(const unsigned long &layerIndex, const unsigned long &columnBegin, const unsigned long &columnEnd)
+{
+	Layer &layer = layers[layerIndex];
+	Layer &prevLayer = layers[layerIndex - 1];
+	auto neuronsSize = layer.neurons.size();
+	auto neuronsData = layer.neurons.data();
+	auto prevLayerNeuronsSize = prevLayer.neurons.size();
+	auto valuesScratchData = valuesScratch.data();
+	// The input layer has no gradient
+	bool propagateError = layerIndex > 1;
+	if (weightPrecision != Precision::Extended)
+	{
+		auto errorData = precisionScratch.data();
+		for (unsigned long column = columnBegin; column < columnEnd; ++column)
+		{
+			errorData[column] = 0.0f;
+		}
+		// The float master weights take the update when kept, otherwise the packed weights are the only copy
+		auto packedWeightsData = layer.packedWeights.data();
+		auto masterWeightsData = layer.masterWeights.empty() ? 0 : layer.masterWeights.data();
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; ++neuronIndex)
+		{
+			auto &neuron = neuronsData[neuronIndex];
+			auto packedRowData = packedWeightsData + neuronIndex * prevLayerNeuronsSize;
+			float gradient = (float)neuron.gradient;
+			long double step = learningRate * neuron.gradient;
+			if (masterWeightsData)
+			{
+				auto masterRowData = masterWeightsData + neuronIndex * prevLayerNeuronsSize;
+				for (unsigned long column = columnBegin; column < columnEnd; ++column)
+				{
+					errorData[column] += Precision::widen(packedRowData[column], weightPrecision) * gradient;
+					masterRowData[column] = (float)(masterRowData[column] + step * valuesScratchData[column]);
+					packedRowData[column] = Precision::narrow(masterRowData[column], weightPrecision);
+				}
+				continue;
+			}
+			for (unsigned long column = columnBegin; column < columnEnd; ++column)
+			{
+				float weight = Precision::widen(packedRowData[column], weightPrecision);
+				errorData[column] += weight * gradient;
+				packedRowData[column] = Precision::narrow((float)(weight + step * valuesScratchData[column]), weightPrecision);
+			}
+		}
+		if (propagateError)
+		{
+			assignGradients(*this, prevLayer, errorData, columnBegin, columnEnd);
+		}
+		return;
+	}
+	auto errorData = errorScratch.data();
+	for (unsigned long column = columnBegin; column < columnEnd; ++column)
+	{
+		errorData[column] = 0.0;
+	}
+	for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; ++neuronIndex)
+	{
+		auto &neuron = neuronsData[neuronIndex];
+		auto neuronWeightsData = neuron.weights.data();
+		long double gradient = neuron.gradient;
+		long double step = learningRate * gradient;
+		if (propagateError)
+		{
+			for (unsigned long column = columnBegin; column < columnEnd; ++column)
+			{
+				errorData[column] += neuronWeightsData[column] * gradient;
+				neuronWeightsData[column] += step * valuesScratchData[column];
+			}
+		}
+		else
+		{
+			for (unsigned long column = columnBegin; column < columnEnd; ++column)
+			{
+				neuronWeightsData[column] += step * valuesScratchData[column];
+			}
+		}
+	}
+	if (propagateError)
+	{
+		assignGradients(*this, prevLayer, errorData, columnBegin, columnEnd);
+	}
+};
+/*
+ * im2col: lays out every kernel-sized window of the previous layer's outputs as one column of a
+ * (inputChannels * kernelHeight * kernelWidth) x (outputHeight * outputWidth) matrix, with zeros for padding
+ */
+static void gatherColumns(const Layer &layer, const Layer &prevLayer, long double *columnsData)
+{
+	auto prevLayerNeuronsData = prevLayer.neurons.data();
+	auto positionsSize = layer.outputHeight * layer.outputWidth;
+	unsigned long row = 0;
+	for (unsigned long channel = 0; channel < layer.inputChannels; ++channel)
+	{
+		auto channelData = prevLayerNeuronsData + channel * layer.inputHeight * layer.inputWidth;
+		for (unsigned long kernelY = 0; kernelY < layer.kernelHeight; ++kernelY)
+		{
+			for (unsigned long kernelX = 0; kernelX < layer.kernelWidth; ++kernelX, ++row)
+			{
+				auto rowData = columnsData + row * positionsSize;
+				for (unsigned long outputY = 0; outputY < layer.outputHeight; ++outputY)
+				{
+					// Unsigned wrap-around turns negative coordinates into out-of-range ones
+					unsigned long inputY = outputY * layer.strideHeight + kernelY - layer.paddingHeight;
+					for (unsigned long outputX = 0; outputX < layer.outputWidth; ++outputX)
+					{
+						unsigned long inputX = outputX * layer.strideWidth + kernelX - layer.paddingWidth;
+						bool inside = inputY < layer.inputHeight && inputX < layer.inputWidth;
+						rowData[outputY * layer.outputWidth + outputX] = inside ? channelData[inputY * layer.inputWidth + inputX].outputValue : 0.0;
+					}
+				}
+			}
+		}
+	}
+};
+/*
+ * Convolution as a GEMM of the kernels (outputChannels x kernelSize) with the im2col matrix
+ */
+void NeuralNetwork::propagateConvolution(const unsigned long &layerIndex)
+{
+	auto &layer = layers[layerIndex];
+	auto kernelSize = layer.inputChannels * layer.kernelHeight * layer.kernelWidth;
+	auto positionsSize = layer.outputHeight * layer.outputWidth;
+	columnsScratch.resize(kernelSize * positionsSize);
+	auto columnsData = columnsScratch.data();
+	gatherColumns(layer, layers[layerIndex - 1], columnsData);
+	auto neuronsData = layer.neurons.data();
+	auto kernelWeightsData = layer.kernelWeights.data();
+	productsScratch.resize(positionsSize);
+	auto productsData = productsScratch.data();
+	for (unsigned long outputChannel = 0; outputChannel < layer.outputChannels; ++outputChannel)
+	{
+		std::fill(productsData, productsData + positionsSize, layer.kernelBiases[outputChannel]);
+		auto kernelData = kernelWeightsData + outputChannel * kernelSize;
+		for (unsigned long row = 0; row < kernelSize; ++row)
+		{
+			long double weight = kernelData[row];
+			auto rowData = columnsData + row * positionsSize;
+			for (unsigned long position = 0; position < positionsSize; ++position)
+			{
+				productsData[position] += weight * rowData[position];
+			}
+		}
+		auto channelNeuronsData = neuronsData + outputChannel * positionsSize;
+		for (unsigned long position = 0; position < positionsSize; ++position)
+		{
+			channelNeuronsData[position].inputValue = productsData[position];
+		}
+	}
+	activateLayer(layer);
+};
+/*
+ */
+void NeuralNetwork::propagatePooling(const unsigned long &layerIndex)
+{
+	auto &layer = layers[layerIndex];
+	auto prevLayerNeuronsData = layers[layerIndex - 1].neurons.data();
+	auto neuronsData = layer.neurons.data();
+	auto positionsSize = layer.outputHeight * layer.outputWidth;
+	long double windowSize = layer.kernelHeight * layer.kernelWidth;
+	layer.poolIndices.resize(layer.neurons.size());
+	auto poolIndicesData = layer.poolIndices.data();
+	for (unsigned long channel = 0; channel < layer.outputChannels; ++channel)
+	{
+		auto channelOffset = channel * layer.inputHeight * layer.inputWidth;
+		for (unsigned long outputY = 0; outputY < layer.outputHeight; ++outputY)
+		{
+			for (unsigned long outputX = 0; outputX < layer.outputWidth; ++outputX)
+			{
+				auto outputIndex = channel * positionsSize + outputY * layer.outputWidth + outputX;
+				unsigned long selectedIndex = channelOffset + outputY * layer.strideHeight * layer.inputWidth + outputX * layer.strideWidth;
+				long double value = layer.type == Layer::MaxPooling ? prevLayerNeuronsData[selectedIndex].outputValue : 0.0;
+				for (unsigned long kernelY = 0; kernelY < layer.kernelHeight; ++kernelY)
+				{
+					for (unsigned long kernelX = 0; kernelX < layer.kernelWidth; ++kernelX)
+					{
+						auto inputIndex = channelOffset + (outputY * layer.strideHeight + kernelY) * layer.inputWidth + outputX * layer.strideWidth + kernelX;
+						long double inputValue = prevLayerNeuronsData[inputIndex].outputValue;
+						if (layer.type == Layer::AveragePooling)
+						{
+							value += inputValue;
+						}
+						else if (inputValue > value)
+						{
+							value = inputValue;
+							selectedIndex = inputIndex;
+						}
+					}
+				}
+				if (layer.type == Layer::AveragePooling)
+				{
+					value /= windowSize;
+				}
+				poolIndicesData[outputIndex] = selectedIndex;
+				neuronsData[outputIndex].inputValue = value;
+				neuronsData[outputIndex].outputValue = value;
+			}
+		}
+	}
+};
+/*
+ * Accumulates the input errors through the transposed kernels and col2im with the old weights, then applies
+ * the kernel and bias updates summed over all output positions
+ */
+void NeuralNetwork::backpropagateConvolution(const unsigned long &layerIndex)
+{
+	auto &layer = layers[layerIndex];
+	auto &prevLayer = layers[layerIndex - 1];
+	auto kernelSize = layer.inputChannels * layer.kernelHeight * layer.kernelWidth;
+	auto positionsSize = layer.outputHeight * layer.outputWidth;
+	columnsScratch.resize(kernelSize * positionsSize);
+	auto columnsData = columnsScratch.data();
+	gatherColumns(layer, prevLayer, columnsData);
+	auto neuronsData = layer.neurons.data();
+	auto kernelWeightsData = layer.kernelWeights.data();
+	// The input layer has no gradient
+	bool propagateError = layerIndex > 1;
+	productsScratch.assign(propagateError ? kernelSize * positionsSize : 0, 0.0);
+	auto productsData = productsScratch.data();
+	valuesScratch.resize(positionsSize);
+	auto gradientsData = valuesScratch.data();
+	for (unsigned long outputChannel = 0; outputChannel < layer.outputChannels; ++outputChannel)
+	{
+		long double biasGradient = 0;
+		for (unsigned long position = 0; position < positionsSize; ++position)
+		{
+			gradientsData[position] = neuronsData[outputChannel * positionsSize + position].gradient;
+			biasGradient += gradientsData[position];
+		}
+		auto kernelData = kernelWeightsData + outputChannel * kernelSize;
+		for (unsigned long row = 0; row < kernelSize; ++row)
+		{
+			auto rowData = columnsData + row * positionsSize;
+			long double weightGradient = 0;
+			if (propagateError)
+			{
+				auto errorRowData = productsData + row * positionsSize;
+				long double weight = kernelData[row];
+				for (unsigned long position = 0; position < positionsSize; ++position)
+				{
+					errorRowData[position] += weight * gradientsData[position];
+					weightGradient += gradientsData[position] * rowData[position];
+				}
+			}
+			else
+			{
+				for (unsigned long position = 0; position < positionsSize; ++position)
+				{
+					weightGradient += gradientsData[position] * rowData[position];
+				}
+			}
+			kernelData[row] += learningRate * weightGradient;
+		}
+		layer.kernelBiases[outputChannel] += learningRate * biasGradient;
+	}
+	if (!propagateError)
+	{
+		return;
+	}
+	// col2im: scatter the column errors back onto the inputs they were gathered from
+	auto prevLayerNeuronsSize = prevLayer.neurons.size();
+	errorScratch.assign(prevLayerNeuronsSize, 0.0);
+	activationScratch.resize(prevLayerNeuronsSize);
+	auto errorData = errorScratch.data();
+	unsigned long row = 0;
+	for (unsigned long channel = 0; channel < layer.inputChannels; ++channel)
+	{
+		auto channelErrorData = errorData + channel * layer.inputHeight * layer.inputWidth;
+		for (unsigned long kernelY = 0; kernelY < layer.kernelHeight; ++kernelY)
+		{
+			for (unsigned long kernelX = 0; kernelX < layer.kernelWidth; ++kernelX, ++row)
+			{
+				auto errorRowData = productsData + row * positionsSize;
+				for (unsigned long outputY = 0; outputY < layer.outputHeight; ++outputY)
+				{
+					unsigned long inputY = outputY * layer.strideHeight + kernelY - layer.paddingHeight;
+					for (unsigned long outputX = 0; outputX < layer.outputWidth; ++outputX)
+					{
+						unsigned long inputX = outputX * layer.strideWidth + kernelX - layer.paddingWidth;
+						if (inputY < layer.inputHeight && inputX < layer.inputWidth)
+						{
+							channelErrorData[inputY * layer.inputWidth + inputX] += errorRowData[outputY * layer.outputWidth + outputX];
+						}
+					}
+				}
+			}
+		}
+	}
+	assignGradients(*this, prevLayer, errorData, 0, prevLayerNeuronsSize);
+};
+/*
+ */
+void NeuralNetwork::backpropagatePooling(const unsigned long &layerIndex)
+{
+	if (layerIndex == 1)
+	{
+		return;
+	}
+	auto &layer = layers[layerIndex];
+	auto &prevLayer = layers[layerIndex - 1];
+	auto prevLayerNeuronsSize = prevLayer.neurons.size();
+	errorScratch.assign(prevLayerNeuronsSize, 0.0);
+	activationScratch.resize(prevLayerNeuronsSize);
+	auto errorData = errorScratch.data();
+	auto neuronsData = layer.neurons.data();
+	auto neuronsSize = layer.neurons.size();
+	if (layer.type == Layer::MaxPooling)
+	{
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; ++neuronIndex)
+		{
+			errorData[layer.poolIndices[neuronIndex]] += neuronsData[neuronIndex].gradient;
+		}
+	}
+	else
+	{
+		auto positionsSize = layer.outputHeight * layer.outputWidth;
+		long double windowSize = layer.kernelHeight * layer.kernelWidth;
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; ++neuronIndex)
+		{
+			auto channel = neuronIndex / positionsSize;
+			auto outputY = (neuronIndex % positionsSize) / layer.outputWidth;
+			auto outputX = neuronIndex % layer.outputWidth;
+			long double error = neuronsData[neuronIndex].gradient / windowSize;
+			for (unsigned long kernelY = 0; kernelY < layer.kernelHeight; ++kernelY)
+			{
+				for (unsigned long kernelX = 0; kernelX < layer.kernelWidth; ++kernelX)
+				{
+					errorData[channel * layer.inputHeight * layer.inputWidth + (outputY * layer.strideHeight + kernelY) * layer.inputWidth + outputX * layer.strideWidth + kernelX] += error;
+				}
+			}
+		}
+	}
+	assignGradients(*this, prevLayer, errorData, 0, prevLayerNeuronsSize);
+};
+/*
+ */
+const bool NeuralNetwork::isDense() const
+{
+	for (auto &layer : layers)
+	{
+		if (layer.type != Layer::Dense)
+		{
+			return false;
+		}
+	}
+	return true;
 };
 /*
  */
 const std::vector<long double> NeuralNetwork::getOutputs() const
 {
-	std::lock_guard<std::mutex> lock((std::mutex&)mutex);
+	auto lock = Tracer::lock((std::mutex&)mutex);
+	return collectOutputs();
+};
+/*
+ */
+const std::vector<long double> NeuralNetwork::collectOutputs() const
+{
 	auto &lastLayer = layers.back();
 	std::vector<long double> outputs;
 	auto neuronsSize = lastLayer.neurons.size();
@@ -236,16 +1022,429 @@ const std::vector<long double> NeuralNetwork::getOutputs() const
 	}
 	return outputs;
 };
+/*
+ */
+const std::vector<long double> NeuralNetwork::predict(const std::vector<long double> &inputValues)
+{
+	NNPP_TRACE_SCOPE("predict", "network");
+	auto lock = Tracer::lock(mutex);
+	propagateForward(inputValues);
+	return collectOutputs();
+};
+/*
+ */
+Executor &NeuralNetwork::getExecutor()
+{
+	return executor ? *executor : Executor::shared();
+};
+/*
+ */
+std::future<std::vector<long double>> NeuralNetwork::inferAsync(const std::vector<long double> &inputValues)
+{
+	auto promise = std::make_shared<std::promise<std::vector<long double>>>();
+	auto future = promise->get_future();
+	getExecutor().submit([this, promise, inputValues]
+	{
+		try
+		{
+			promise->set_value(predict(inputValues));
+		}
+		catch (...)
+		{
+			promise->set_exception(std::current_exception());
+		}
+	}, Executor::High);
+	return future;
+};
+/*
+ */
+InferenceAwaitable NeuralNetwork::infer(const std::vector<long double> &inputValues)
+{
+	return {*this, inputValues};
+};
+/*
+ */
+void InferenceAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+	network.getExecutor().submit([this, handle]
+	{
+		try
+		{
+			outputValues = network.predict(inputValues);
+		}
+		catch (...)
+		{
+			exception = std::current_exception();
+		}
+		handle.resume();
+	}, Executor::High);
+};
+/*
+ */
+std::vector<long double> InferenceAwaitable::await_resume()
+{
+	if (exception)
+	{
+		std::rethrow_exception(exception);
+	}
+	return std::move(outputValues);
+};
 /*
  */
 ByteStream NeuralNetwork::serialize() const
 {
+	NNPP_TRACE_SCOPE("serialize", "io");
 	ByteStream byteStream;
 	byteStream.write<const long double &>(learningRate);
 	byteStream.write<const unsigned int &>((unsigned int)activationType);
 	byteStream.write<const std::vector<Layer> &>(layers);
+	// Trailing fields, absent from streams written by older versions
+	byteStream.write<const unsigned int &>((unsigned int)weightPrecision);
+	byteStream.write<const unsigned int &>((unsigned int)keepMasterWeights);
+	byteStream.write<const unsigned int &>((unsigned int)activationAccuracy);
+	for (auto &layer : layers)
+	{
+		byteStream.write<const unsigned int &>((unsigned int)layer.type);
+		if (layer.type == Layer::Dense)
+		{
+			continue;
+		}
+		for (auto value : {layer.inputChannels, layer.inputHeight, layer.inputWidth, layer.outputChannels, layer.outputHeight, layer.outputWidth,
+			layer.kernelHeight, layer.kernelWidth, layer.strideHeight, layer.strideWidth, layer.paddingHeight, layer.paddingWidth})
+		{
+			byteStream.write<const unsigned int &>((unsigned int)value);
+		}
+		byteStream.write<const std::vector<long double> &>(layer.kernelWeights);
+		byteStream.write<const std::vector<long double> &>(layer.kernelBiases);
+	}
+	byteStream.write<const unsigned int &>((unsigned int)outputMode);
+	// Reduced precision weights are written as stored, the neurons' long double weights are empty
+	for (unsigned long layerIndex = 1; weightPrecision != Precision::Extended && layerIndex < layers.size(); layerIndex++)
+	{
+		auto &layer = layers[layerIndex];
+		if (layer.type == Layer::Dense)
+		{
+			byteStream.write<const std::vector<uint16_t> &>(layer.packedWeights);
+			byteStream.write<const std::vector<float> &>(layer.masterWeights);
+		}
+	}
 	return byteStream;
 };
+/*
+ * Replaces this network's model with source's: every field serialize writes, so the outputs match source's
+ */
+void NeuralNetwork::copyModel(const NeuralNetwork &source)
+{
+	auto lock = Tracer::lock(mutex);
+	learningRate = source.learningRate;
+	activationType = source.activationType;
+	activation = source.activation;
+	derivative = source.derivative;
+	layers = source.layers;
+	weightPrecision = source.weightPrecision;
+	keepMasterWeights = source.keepMasterWeights;
+	activationAccuracy = source.activationAccuracy;
+	outputMode = source.outputMode;
+	parametersVersion++;
+};
+/*
+ */
+void NeuralNetwork::setWeightPrecision(const Precision::Type &precision, const bool &keepMasterWeights)
+{
+	auto lock = Tracer::lock(mutex);
+	weightPrecision = precision;
+	this->keepMasterWeights = keepMasterWeights;
+	parametersVersion++;
+	auto layersSize = layers.size();
+	for (unsigned long layerIndex = 1; layerIndex < layersSize; layerIndex++)
+	{
+		layers[layerIndex].pack(precision, keepMasterWeights);
+	}
+	if (precision == Precision::Extended || layers.empty())
+	{
+		return;
+	}
+	// Nothing reads the input layer's weights, reduced precision networks release them as well
+	for (auto &neuron : layers[0].neurons)
+	{
+		std::vector<long double>().swap(neuron.weights);
+	}
+};
+/*
+ * Approximate heap and object size of the network: its layers, neurons, weights and scratch buffers
+ */
+const unsigned long NeuralNetwork::memoryBytes() const
+{
+	unsigned long bytes = sizeof(NeuralNetwork);
+	for (auto &layer : layers)
+	{
+		bytes += sizeof(Layer) + layer.neurons.capacity() * sizeof(Neuron) + layer.packedWeights.capacity() * sizeof(uint16_t) +
+			layer.masterWeights.capacity() * sizeof(float);
+		bytes += (layer.kernelWeights.capacity() + layer.kernelBiases.capacity()) * sizeof(long double);
+		bytes += layer.poolIndices.capacity() * sizeof(unsigned long);
+		for (auto &neuron : layer.neurons)
+		{
+			bytes += neuron.weights.capacity() * sizeof(long double);
+		}
+	}
+	bytes += (valuesScratch.capacity() + errorScratch.capacity() + columnsScratch.capacity() + productsScratch.capacity()) * sizeof(long double);
+	bytes += precisionScratch.capacity() * sizeof(float) + activationScratch.capacity() * sizeof(double);
+	return bytes;
+};
+/*
+ * One pass over the dataset split into one chunk per worker plus the calling thread. Each chunk reduces into its
+ * own partial, merged in chunk order afterwards, so the result does not depend on scheduling. Networks a
+ * PackedNetwork supports are predicted lock free from a packed copy without allocating per sample, others go
+ * through predict and its lock.
+ */
+const NeuralNetwork::Evaluation NeuralNetwork::evaluate(const Dataset &dataset, const unsigned long &metrics)
+{
+	NNPP_TRACE_SCOPE("evaluate", "network");
+	struct Partial
+	{
+		long double squaredError = 0;
+		long double absoluteError = 0;
+		long double crossEntropy = 0;
+		long double maxError = 0;
+		unsigned long accurate = 0;
+		unsigned long outputs = 0;
+	};
+	Evaluation evaluation;
+	auto samplesSize = dataset.size();
+	evaluation.samples = samplesSize;
+	if (samplesSize == 0 || layers.empty())
+	{
+		return evaluation;
+	}
+	std::unique_ptr<PackedNetwork> packed;
+	if (layers.size() > 1 && PackedNetwork::supports(*this))
+	{
+		packed = std::make_unique<PackedNetwork>(*this);
+	}
+	auto &pool = getExecutor();
+	static const unsigned long grainSize = 64;
+	auto chunksCount = packed ? (std::min)((samplesSize + grainSize - 1) / grainSize, pool.size() + 1) : 1;
+	std::vector<Partial> partials(chunksCount);
+	auto outputsSize = layers.back().neurons.size();
+	auto softmaxOutputs = outputMode == SoftmaxCrossEntropy;
+	static const long double epsilon = 1e-15;
+	auto evaluateChunk = [&](const unsigned long &chunk)
+	{
+		auto &partial = partials[chunk];
+		std::vector<long double> outputs(outputsSize);
+		std::vector<long double> scratch(packed ? 2 * packed->maxLayerSize : 0);
+		for (unsigned long sampleIndex = samplesSize * chunk / chunksCount; sampleIndex < samplesSize * (chunk + 1) / chunksCount; sampleIndex++)
+		{
+			if (packed)
+			{
+				packed->predict(dataset.inputs[sampleIndex].data(), outputs.data(), scratch.data());
+			}
+			else
+			{
+				outputs = predict(dataset.inputs[sampleIndex]);
+			}
+			auto &targets = dataset.outputs[sampleIndex];
+			unsigned long largestOutput = 0;
+			unsigned long largestTarget = 0;
+			for (unsigned long outputIndex = 0; outputIndex < outputsSize; outputIndex++)
+			{
+				auto output = outputs[outputIndex];
+				auto target = targets[outputIndex];
+				auto error = std::abs(output - target);
+				partial.squaredError += error * error;
+				partial.absoluteError += error;
+				partial.maxError = (std::max)(partial.maxError, error);
+				if (metrics & CrossEntropy)
+				{
+					auto probability = std::clamp(output, epsilon, 1 - epsilon);
+					partial.crossEntropy -= softmaxOutputs ? target * std::log(probability) :
+						target * std::log(probability) + (1 - target) * std::log(1 - probability);
+				}
+				largestOutput = output > outputs[largestOutput] ? outputIndex : largestOutput;
+				largestTarget = target > targets[largestTarget] ? outputIndex : largestTarget;
+			}
+			partial.accurate += outputsSize == 1 ? (outputs[0] >= 0.5) == (targets[0] >= 0.5) : largestOutput == largestTarget;
+			partial.outputs += outputsSize;
+		}
+	};
+	pool.parallelFor(0, chunksCount, 1, [&](unsigned long begin, unsigned long end)
+	{
+		for (unsigned long chunk = begin; chunk < end; chunk++)
+		{
+			evaluateChunk(chunk);
+		}
+	});
+	Partial total;
+	for (auto &partial : partials)
+	{
+		total.squaredError += partial.squaredError;
+		total.absoluteError += partial.absoluteError;
+		total.crossEntropy += partial.crossEntropy;
+		total.maxError = (std::max)(total.maxError, partial.maxError);
+		total.accurate += partial.accurate;
+		total.outputs += partial.outputs;
+	}
+	if (metrics & MeanSquaredError)
+	{
+		evaluation.meanSquaredError = total.squaredError / total.outputs;
+	}
+	if (metrics & MeanAbsoluteError)
+	{
+		evaluation.meanAbsoluteError = total.absoluteError / total.outputs;
+	}
+	if (metrics & CrossEntropy)
+	{
+		evaluation.crossEntropy = total.crossEntropy / (softmaxOutputs ? samplesSize : total.outputs);
+	}
+	if (metrics & Accuracy)
+	{
+		evaluation.accuracy = (long double)total.accurate / samplesSize;
+	}
+	if (metrics & MaxError)
+	{
+		evaluation.maxError = total.maxError;
+	}
+	return evaluation;
+};
+/*
+ * Flattens the weights and biases of every layer after the input layer, each neuron's weights followed by its bias
+ */
+const std::vector<long double> NeuralNetwork::getParameters()
+{
+	auto lock = Tracer::lock(mutex);
+	std::vector<long double> parameters;
+	auto layersSize = layers.size();
+	for (unsigned long layerIndex = 1; layerIndex < layersSize; layerIndex++)
+	{
+		auto &layer = layers[layerIndex];
+		if (layer.type != Layer::Dense)
+		{
+			// Kernels followed by their biases, pooling layers have no parameters
+			parameters.insert(parameters.end(), layer.kernelWeights.begin(), layer.kernelWeights.end());
+			parameters.insert(parameters.end(), layer.kernelBiases.begin(), layer.kernelBiases.end());
+			continue;
+		}
+		auto neuronsSize = layer.neurons.size();
+		auto inputsSize = layer.inputsSize();
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+		{
+			auto &neuron = layer.neurons[neuronIndex];
+			if (layer.weightPrecision == Precision::Extended)
+			{
+				parameters.insert(parameters.end(), neuron.weights.begin(), neuron.weights.end());
+			}
+			else
+			{
+				for (unsigned long inputIndex = 0; inputIndex < inputsSize; inputIndex++)
+				{
+					parameters.push_back(layer.weight(neuronIndex, inputIndex));
+				}
+			}
+			parameters.push_back(neuron.bias);
+		}
+	}
+	return parameters;
+};
+/*
+ */
+void NeuralNetwork::setParameters(const std::vector<long double> &parameters)
+{
+	auto lock = Tracer::lock(mutex);
+	auto parametersData = parameters.data();
+	auto parametersSize = parameters.size();
+	unsigned long parameterIndex = 0;
+	auto layersSize = layers.size();
+	for (unsigned long layerIndex = 1; layerIndex < layersSize; layerIndex++)
+	{
+		auto &layer = layers[layerIndex];
+		if (layer.type != Layer::Dense)
+		{
+			auto kernelWeightsSize = layer.kernelWeights.size();
+			auto kernelBiasesSize = layer.kernelBiases.size();
+			if (parameterIndex + kernelWeightsSize + kernelBiasesSize > parametersSize)
+			{
+				throw std::runtime_error("NeuralNetwork: parameters do not match the network topology");
+			}
+			std::copy(parametersData + parameterIndex, parametersData + parameterIndex + kernelWeightsSize, layer.kernelWeights.begin());
+			parameterIndex += kernelWeightsSize;
+			std::copy(parametersData + parameterIndex, parametersData + parameterIndex + kernelBiasesSize, layer.kernelBiases.begin());
+			parameterIndex += kernelBiasesSize;
+			continue;
+		}
+		auto neuronsSize = layer.neurons.size();
+		auto weightsSize = layer.inputsSize();
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+		{
+			auto &neuron = layer.neurons[neuronIndex];
+			if (parameterIndex + weightsSize + 1 > parametersSize)
+			{
+				throw std::runtime_error("NeuralNetwork: parameters do not match the network topology");
+			}
+			if (layer.weightPrecision == Precision::Extended)
+			{
+				std::copy(parametersData + parameterIndex, parametersData + parameterIndex + weightsSize, neuron.weights.begin());
+			}
+			else
+			{
+				for (unsigned long inputIndex = 0; inputIndex < weightsSize; inputIndex++)
+				{
+					layer.setWeight(neuronIndex, inputIndex, parametersData[parameterIndex + inputIndex]);
+				}
+			}
+			parameterIndex += weightsSize;
+			neuron.bias = parametersData[parameterIndex++];
+		}
+	}
+	if (parameterIndex != parametersSize)
+	{
+		throw std::runtime_error("NeuralNetwork: parameters do not match the network topology");
+	}
+	parametersVersion++;
+};
+/*
+ */
+void NeuralNetwork::save(const std::string &filename) const
+{
+	NNPP_TRACE_SCOPE("save", "io");
+	auto byteStream = serialize();
+	std::ofstream file(filename, std::ios::binary);
+	if (!file.is_open())
+	{
+		throw std::ios_base::failure("Error: Unable to open file for writing.");
+	}
+	file.write(byteStream.bytes.get(), static_cast<std::streamsize>(byteStream.bytesSize));
+	if (!file)
+	{
+		throw std::ios_base::failure("Error: Writing to the file failed.");
+	}
+};
+/*
+ * Throws std::runtime_error for a truncated or malformed model, see the deserializing constructor
+ */
+std::shared_ptr<NeuralNetwork> NeuralNetwork::load(const std::string &filename)
+{
+	NNPP_TRACE_SCOPE("load", "io");
+	std::ifstream file(filename, std::ios::binary | std::ios::ate);
+	if (!file.is_open())
+	{
+		throw std::ios_base::failure("Error: Unable to open file for reading.");
+	}
+	std::streampos fileSize = file.tellg();
+	if (fileSize <= 0)
+	{
+		throw std::ios_base::failure("Error: File is empty or has invalid size.");
+	}
+	unsigned long size = static_cast<unsigned long>(fileSize);
+	std::shared_ptr<char> buffer(new char[size], std::default_delete<char[]>());
+	file.seekg(0, std::ios::beg);
+	file.read(buffer.get(), size);
+	if (!file)
+	{
+		throw std::ios_base::failure("Error: Reading the file failed.");
+	}
+	ByteStream byteStream(size, buffer);
+	return std::make_shared<NeuralNetwork>(byteStream);
+};
 /*
  */
 const long double sigmoidActivation(const long double &x)
@@ -0,0 +1,149 @@
+/*
+ */
+#include <Numa.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+using namespace nnpp;
+/*
+ */
+static const std::vector<unsigned long> parseCpuList(const std::string &cpuList)
+{
+	std::vector<unsigned long> cpus;
+	std::stringstream stream(cpuList);
+	std::string range;
+	while (std::getline(stream, range, ','))
+	{
+		if (range.empty() || range == "\n")
+		{
+			continue;
+		}
+		auto dashIndex = range.find('-');
+		unsigned long first = std::stoul(range.substr(0, dashIndex));
+		unsigned long last = dashIndex == std::string::npos ? first : std::stoul(range.substr(dashIndex + 1));
+		for (unsigned long cpu = first; cpu <= last; cpu++)
+		{
+			cpus.push_back(cpu);
+		}
+	}
+	return cpus;
+};
+/*
+ */
+const unsigned long Numa::nodeCount()
+{
+#ifdef __linux__
+	std::ifstream file("/sys/devices/system/node/online");
+	std::string online;
+	if (file >> online)
+	{
+		auto nodes = parseCpuList(online);
+		if (!nodes.empty())
+		{
+			return nodes.back() + 1;
+		}
+	}
+#endif
+	return 1;
+};
+/*
+ */
+const std::vector<unsigned long> Numa::nodeCpus(const unsigned long &node)
+{
+#ifdef __linux__
+	std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+	std::string cpuList;
+	if (file >> cpuList)
+	{
+		return parseCpuList(cpuList);
+	}
+#endif
+	return {};
+};
+/*
+ */
+const unsigned long Numa::currentNode()
+{
+#ifdef __linux__
+	unsigned int cpu = 0;
+	unsigned int node = 0;
+	if (getcpu(&cpu, &node) == 0)
+	{
+		return node;
+	}
+#endif
+	return 0;
+};
+/*
+ */
+const bool Numa::pinThreadToNode(const unsigned long &node)
+{
+	return pinThreadToCpus(nodeCpus(node));
+};
+/*
+ */
+const bool Numa::pinThreadToCpus(const std::vector<unsigned long> &cpus)
+{
+#ifdef __linux__
+	if (cpus.empty())
+	{
+		return false;
+	}
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	for (auto &cpu : cpus)
+	{
+		CPU_SET(cpu, &cpuSet);
+	}
+	return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+	return false;
+#endif
+};
+/*
+ */
+void *Numa::allocate(const unsigned long &bytes, const bool &hugePages)
+{
+#ifdef __linux__
+	void *pointer = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (pointer == MAP_FAILED)
+	{
+		throw std::bad_alloc();
+	}
+	if (hugePages)
+	{
+		madvise(pointer, bytes, MADV_HUGEPAGE);
+	}
+	return pointer;
+#else
+	void *pointer = std::malloc(bytes);
+	if (!pointer)
+	{
+		throw std::bad_alloc();
+	}
+	return pointer;
+#endif
+};
+/*
+ */
+void Numa::deallocate(void *pointer, const unsigned long &bytes)
+{
+	if (!pointer)
+	{
+		return;
+	}
+#ifdef __linux__
+	munmap(pointer, bytes);
+#else
+	std::free(pointer);
+#endif
+};
+/*
+ */
@@ -0,0 +1,133 @@
+/*
+ */
+#include <OnlineLearner.hpp>
+#include <ByteStream.hpp>
+#include <Tracer.hpp>
+#include <functional>
+using namespace nnpp;
+/*
+ */
+static const unsigned long readerStripe()
+{
+	thread_local unsigned long stripe = std::hash<std::thread::id>()(std::this_thread::get_id()) % OnlineLearner::readerStripes;
+	return stripe;
+};
+/*
+ */
+OnlineLearner::OnlineLearner(const NeuralNetwork &network, const unsigned long &publishInterval, const unsigned long &feedbackCapacity):
+	publishInterval(publishInterval),
+	feedbackQueue(feedbackCapacity)
+{
+	auto byteStream = network.serialize();
+	this->network = std::make_unique<NeuralNetwork>(byteStream);
+	snapshot = new PackedNetwork(*this->network);
+};
+/*
+ */
+OnlineLearner::~OnlineLearner()
+{
+	stop();
+	delete snapshot.load();
+};
+/*
+ * Lock free: registers in the current epoch's counter, retrying if the epoch flips in between, so a reader that
+ * loaded a snapshot is always visible to the publish that retires it
+ */
+const std::vector<long double> OnlineLearner::predict(const std::vector<long double> &inputValues)
+{
+	auto stripe = readerStripe();
+	unsigned long readerEpoch;
+	while (true)
+	{
+		readerEpoch = epoch.load() & 1;
+		readers[readerEpoch][stripe].count++;
+		if ((epoch.load() & 1) == readerEpoch)
+		{
+			break;
+		}
+		readers[readerEpoch][stripe].count--;
+	}
+	auto outputValues = snapshot.load()->predict(inputValues);
+	readers[readerEpoch][stripe].count--;
+	return outputValues;
+};
+/*
+ */
+void OnlineLearner::learn(const std::vector<long double> &inputValues, const std::vector<long double> &targetValues)
+{
+	std::lock_guard<std::mutex> lock(learnerMutex);
+	network->feedforward(inputValues);
+	network->backpropagate(targetValues);
+	samplesSincePublish++;
+	if (publishInterval && samplesSincePublish >= publishInterval)
+	{
+		publishLocked();
+	}
+};
+/*
+ */
+void OnlineLearner::publish()
+{
+	std::lock_guard<std::mutex> lock(learnerMutex);
+	publishLocked();
+};
+/*
+ */
+void OnlineLearner::publishLocked()
+{
+	NNPP_TRACE_SCOPE("publish", "online");
+	auto retired = snapshot.exchange(new PackedNetwork(*network));
+	samplesSincePublish = 0;
+	publishedVersion++;
+	// Readers that may hold the retired snapshot registered under the old epoch, wait for them to leave. Readers
+	// of the new epoch only ever load the new snapshot
+	auto oldEpoch = epoch.fetch_add(1) & 1;
+	for (auto &counter : readers[oldEpoch])
+	{
+		while (counter.count.load() != 0)
+		{
+			std::this_thread::yield();
+		}
+	}
+	delete retired;
+};
+/*
+ */
+void OnlineLearner::start()
+{
+	if (learnerThread.joinable())
+	{
+		return;
+	}
+	learnerThread = std::thread([this]
+	{
+		Executor::CoreReservation learnerCore;
+		Feedback item;
+		while (feedbackQueue.pop(item))
+		{
+			learn(item.inputValues, item.targetValues);
+		}
+		publish();
+	});
+};
+/*
+ * Learns the feedback already queued, publishes and joins the learner thread
+ */
+void OnlineLearner::stop()
+{
+	feedbackQueue.close();
+	if (learnerThread.joinable())
+	{
+		learnerThread.join();
+	}
+};
+/*
+ * Queues a sample for the learner thread without blocking, returns false when the queue is full and the sample
+ * is dropped
+ */
+const bool OnlineLearner::feedback(const std::vector<long double> &inputValues, const std::vector<long double> &targetValues)
+{
+	return feedbackQueue.tryPush({inputValues, targetValues});
+};
+/*
+ */
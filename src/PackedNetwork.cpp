@@ -0,0 +1,145 @@
+/*
+ */
+#include <PackedNetwork.hpp>
+#include <Numa.hpp>
+#include <Activations.hpp>
+#include <Tracer.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+using namespace nnpp;
+/*
+ */
+PackedNetwork::PackedNetwork(const NeuralNetwork &network, const bool &hugePages):
+	activationType(network.activationType),
+	outputMode(network.outputMode),
+	activationAccuracy(network.activationAccuracy),
+	activation(network.activation)
+{
+	auto lock = Tracer::lock((std::mutex&)network.mutex);
+	if (!network.isDense())
+	{
+		throw std::runtime_error("PackedNetwork supports dense layers only");
+	}
+	if (network.weightPrecision != Precision::Extended)
+	{
+		throw std::runtime_error("PackedNetwork supports Extended weight precision only");
+	}
+	auto layersSize = network.layers.size();
+	auto layersData = network.layers.data();
+	for (unsigned long layerIndex = 0; layerIndex < layersSize; layerIndex++)
+	{
+		auto neuronsSize = layersData[layerIndex].neurons.size();
+		layerSizes.push_back(neuronsSize);
+		maxLayerSize = (std::max)(maxLayerSize, neuronsSize);
+		layerOffsets.push_back(parametersSize);
+		if (layerIndex > 0)
+		{
+			parametersSize += neuronsSize * (layerSizes[layerIndex - 1] + 1);
+		}
+	}
+	parameters = (long double *)Numa::allocate(std::max(parametersSize, 1ul) * sizeof(long double), hugePages);
+	for (unsigned long layerIndex = 1; layerIndex < layersSize; layerIndex++)
+	{
+		auto &neurons = layersData[layerIndex].neurons;
+		auto neuronsSize = neurons.size();
+		auto previousSize = layerSizes[layerIndex - 1];
+		auto weights = parameters + layerOffsets[layerIndex];
+		auto biases = weights + neuronsSize * previousSize;
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+		{
+			std::memcpy(weights + neuronIndex * previousSize, neurons[neuronIndex].weights.data(), previousSize * sizeof(long double));
+			biases[neuronIndex] = neurons[neuronIndex].bias;
+		}
+	}
+};
+/*
+ */
+PackedNetwork::~PackedNetwork()
+{
+	Numa::deallocate(parameters, std::max(parametersSize, 1ul) * sizeof(long double));
+};
+/*
+ */
+void PackedNetwork::predict(const long double *inputValues, long double *outputValues, long double *scratch) const
+{
+	auto layersSize = layerSizes.size();
+	const long double *previousValues = inputValues;
+	long double *currentValues = scratch;
+	for (unsigned long layerIndex = 1; layerIndex < layersSize; layerIndex++)
+	{
+		auto neuronsSize = layerSizes[layerIndex];
+		auto previousSize = layerSizes[layerIndex - 1];
+		auto weights = parameters + layerOffsets[layerIndex];
+		auto biases = weights + neuronsSize * previousSize;
+		if (layerIndex == layersSize - 1)
+		{
+			currentValues = outputValues;
+		}
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+		{
+			auto row = weights + neuronIndex * previousSize;
+			long double inputValue = 0.0;
+			for (unsigned long n = 0; n < previousSize; n++)
+			{
+				inputValue += previousValues[n] * row[n];
+			}
+			currentValues[neuronIndex] = inputValue + biases[neuronIndex];
+		}
+		auto softmax = outputMode == NeuralNetwork::SoftmaxCrossEntropy && layerIndex == layersSize - 1;
+		if (activationAccuracy != NeuralNetwork::Exact)
+		{
+			// Same double precision array forms as NeuralNetwork::activateLayer and activateSoftmax
+			thread_local std::vector<double> activationScratch;
+			activationScratch.assign(currentValues, currentValues + neuronsSize);
+			if (softmax)
+			{
+				Activations::softmax(activationAccuracy, activationScratch.data(), neuronsSize);
+			}
+			else
+			{
+				Activations::activate(activationType, activationAccuracy, activationScratch.data(), neuronsSize);
+			}
+			std::copy(activationScratch.begin(), activationScratch.end(), currentValues);
+		}
+		else if (softmax)
+		{
+			Activations::softmax(NeuralNetwork::Exact, currentValues, neuronsSize);
+		}
+		else
+		{
+			for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+			{
+				currentValues[neuronIndex] = activation(currentValues[neuronIndex]);
+			}
+		}
+		previousValues = currentValues;
+		currentValues = (currentValues == scratch) ? scratch + maxLayerSize : scratch;
+	}
+};
+/*
+ */
+const std::vector<long double> PackedNetwork::predict(const std::vector<long double> &inputValues) const
+{
+	std::vector<long double> outputValues(layerSizes.back());
+	if (layerSizes.size() == 1)
+	{
+		std::copy_n(inputValues.begin(), outputValues.size(), outputValues.begin());
+		return outputValues;
+	}
+	thread_local std::vector<long double> scratch;
+	if (scratch.size() < 2 * maxLayerSize)
+	{
+		scratch.resize(2 * maxLayerSize);
+	}
+	predict(inputValues.data(), outputValues.data(), scratch.data());
+	return outputValues;
+};
+/*
+ */
+const bool PackedNetwork::supports(const NeuralNetwork &network)
+{
+	return network.isDense() && network.weightPrecision == Precision::Extended;
+};
+/*
+ */
@@ -0,0 +1,616 @@
+/*
+ */
+#include <PipelineTrainer.hpp>
+#include <Activations.hpp>
+#include <Tracer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+using namespace nnpp;
+/*
+ */
+PipelineTrainer::PipelineTrainer(NeuralNetwork &network, const unsigned long &stagesCount, const unsigned long &microBatchSize, const unsigned long &queueCapacity):
+	network(network),
+	microBatchSize(microBatchSize ? microBatchSize : 1),
+	queueCapacity(queueCapacity)
+{
+	if (!network.isDense())
+	{
+		throw std::runtime_error("PipelineTrainer supports dense layers only");
+	}
+	auto layersSize = network.layers.size();
+	if (stagesCount == 0 || stagesCount > layersSize - 1)
+	{
+		throw std::runtime_error("PipelineTrainer: stages count must be between 1 and the number of trainable layers");
+	}
+	// Balance the stages by weight count, leaving at least one layer for every remaining stage
+	unsigned long totalWeights = 0;
+	for (unsigned long layerIndex = 1; layerIndex < layersSize; layerIndex++)
+	{
+		totalWeights += network.layers[layerIndex].neurons.size() * network.layers[layerIndex - 1].neurons.size();
+	}
+	unsigned long layerIndex = 1;
+	unsigned long accumulatedWeights = 0;
+	for (unsigned long stageIndex = 0; stageIndex < stagesCount; stageIndex++)
+	{
+		Stage stage;
+		stage.layerBegin = layerIndex;
+		auto stageTarget = totalWeights * (stageIndex + 1) / stagesCount;
+		do
+		{
+			auto &layer = network.layers[layerIndex];
+			auto inputsSize = network.layers[layerIndex - 1].neurons.size();
+			accumulatedWeights += layer.neurons.size() * inputsSize;
+			stage.weightGradients.emplace_back(layer.neurons.size() * inputsSize, 0);
+			stage.biasGradients.emplace_back(layer.neurons.size(), 0);
+			layerIndex++;
+		}
+		while (layerIndex < layersSize - (stagesCount - stageIndex - 1) && (accumulatedWeights < stageTarget || stageIndex == stagesCount - 1));
+		stage.layerEnd = layerIndex;
+		stages.push_back(std::move(stage));
+	}
+	for (unsigned long stageIndex = 1; stageIndex < stagesCount; stageIndex++)
+	{
+		workers.emplace_back([this, stageIndex]
+		{
+			runWorker(stageIndex);
+		});
+	}
+};
+/*
+ */
+PipelineTrainer::~PipelineTrainer()
+{
+	{
+		std::lock_guard<std::mutex> lock(roundMutex);
+		stopping = true;
+	}
+	roundCondition.notify_all();
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
+};
+/*
+ */
+const long double PipelineTrainer::train(const Dataset &dataset, const unsigned long &batchSize)
+{
+	if (batchSize == 0)
+	{
+		throw std::runtime_error("PipelineTrainer: batch size must be positive");
+	}
+	auto lock = Tracer::lock(network.mutex);
+	auto stagesSize = stages.size();
+	// The backward queues must absorb a whole batch, since the last stage returns errors while the earlier
+	// stages are still pushing forward
+	auto microBatchesPerBatch = (batchSize + microBatchSize - 1) / microBatchSize;
+	forwardQueues.clear();
+	backwardQueues.clear();
+	for (unsigned long stageIndex = 0; stageIndex + 1 < stagesSize; stageIndex++)
+	{
+		forwardQueues.push_back(std::make_unique<BoundedQueue<MicroBatch>>(queueCapacity));
+		backwardQueues.push_back(std::make_unique<BoundedQueue<MicroBatch>>((std::max)(queueCapacity, microBatchesPerBatch)));
+	}
+	for (auto &stage : stages)
+	{
+		stage.busySeconds = 0;
+		stage.stashedValues = 0;
+		stage.peakStashedValues = 0;
+	}
+	effectiveCheckpointInterval = memoryBudget ? chooseCheckpointInterval((std::min)(batchSize, dataset.size())) : (std::max)(1ul, checkpointInterval);
+	// The workers count against the core budget while a round runs, the calling thread runs the first stage
+	Executor::CoreReservation workersCores(stagesSize - 1);
+	auto start = std::chrono::steady_clock::now();
+	{
+		std::lock_guard<std::mutex> roundLock(roundMutex);
+		roundDataset = &dataset;
+		roundBatchSize = batchSize;
+		roundLoss = 0;
+		roundException = 0;
+		stagesRunning = stagesSize - 1;
+		round++;
+	}
+	roundCondition.notify_all();
+	runRound(0);
+	std::unique_lock<std::mutex> roundLock(roundMutex);
+	roundCondition.wait(roundLock, [&]
+	{
+		return stagesRunning == 0;
+	});
+	elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	if (roundException)
+	{
+		std::rethrow_exception(roundException);
+	}
+	auto valuesCount = dataset.size() * network.layers.back().neurons.size();
+	return valuesCount ? roundLoss / valuesCount : 0;
+};
+/*
+ * Runs one stage for every round until the trainer is destroyed
+ */
+void PipelineTrainer::runWorker(const unsigned long &stageIndex)
+{
+	unsigned long workerRound = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(roundMutex);
+			roundCondition.wait(lock, [&]
+			{
+				return stopping || round != workerRound;
+			});
+			if (stopping)
+			{
+				return;
+			}
+			workerRound = round;
+		}
+		runRound(stageIndex);
+		{
+			std::lock_guard<std::mutex> lock(roundMutex);
+			stagesRunning--;
+		}
+		roundCondition.notify_all();
+	}
+};
+/*
+ */
+void PipelineTrainer::runRound(const unsigned long &stageIndex)
+{
+	try
+	{
+		runStage(stageIndex, *roundDataset, roundBatchSize, roundLoss);
+	}
+	catch (...)
+	{
+		{
+			std::lock_guard<std::mutex> lock(roundMutex);
+			if (!roundException)
+			{
+				roundException = std::current_exception();
+			}
+		}
+		// Unblock the other stages so they can finish the round
+		for (auto &queue : forwardQueues)
+		{
+			queue->close();
+		}
+		for (auto &queue : backwardQueues)
+		{
+			queue->close();
+		}
+	}
+};
+/*
+ */
+void PipelineTrainer::runStage(const unsigned long &stageIndex, const Dataset &dataset, const unsigned long &batchSize, long double &loss)
+{
+	auto &stage = stages[stageIndex];
+	bool firstStage = stageIndex == 0;
+	bool lastStage = stageIndex == stages.size() - 1;
+	auto datasetSize = dataset.size();
+	std::vector<std::vector<std::vector<long double>>> stashes;
+	for (unsigned long batchBegin = 0; batchBegin < datasetSize; batchBegin += batchSize)
+	{
+		auto batchEnd = (std::min)(batchBegin + batchSize, datasetSize);
+		auto microBatchesSize = (batchEnd - batchBegin + microBatchSize - 1) / microBatchSize;
+		stashes.resize(microBatchesSize);
+		for (unsigned long microBatchIndex = 0; microBatchIndex < microBatchesSize; microBatchIndex++)
+		{
+			MicroBatch microBatch;
+			if (firstStage)
+			{
+				auto sampleBegin = batchBegin + microBatchIndex * microBatchSize;
+				auto sampleEnd = (std::min)(sampleBegin + microBatchSize, batchEnd);
+				microBatch.index = microBatchIndex;
+				microBatch.values.assign(dataset.inputs.begin() + sampleBegin, dataset.inputs.begin() + sampleEnd);
+			}
+			else if (!forwardQueues[stageIndex - 1]->pop(microBatch))
+			{
+				return;
+			}
+			auto busyStart = std::chrono::steady_clock::now();
+			forward(stage, microBatch, stashes[microBatch.index]);
+			if (!lastStage)
+			{
+				stage.busySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - busyStart).count();
+				if (!forwardQueues[stageIndex]->push(std::move(microBatch)))
+				{
+					return;
+				}
+				continue;
+			}
+			// The last stage turns its outputs into errors and starts the backward pass right away
+			auto sampleBegin = batchBegin + microBatch.index * microBatchSize;
+			auto valuesSize = microBatch.values.size();
+			for (unsigned long sampleIndex = 0; sampleIndex < valuesSize; sampleIndex++)
+			{
+				auto &row = microBatch.values[sampleIndex];
+				auto &targets = dataset.outputs[sampleBegin + sampleIndex];
+				auto rowSize = row.size();
+				for (unsigned long outputIndex = 0; outputIndex < rowSize; outputIndex++)
+				{
+					row[outputIndex] = targets[outputIndex] - row[outputIndex];
+					loss += row[outputIndex] * row[outputIndex];
+				}
+			}
+			backward(stage, microBatch, stashes[microBatch.index]);
+			stage.busySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - busyStart).count();
+			if (!firstStage && !backwardQueues[stageIndex - 1]->push(std::move(microBatch)))
+			{
+				return;
+			}
+		}
+		if (!lastStage)
+		{
+			for (unsigned long microBatchIndex = 0; microBatchIndex < microBatchesSize; microBatchIndex++)
+			{
+				MicroBatch microBatch;
+				if (!backwardQueues[stageIndex]->pop(microBatch))
+				{
+					return;
+				}
+				auto busyStart = std::chrono::steady_clock::now();
+				backward(stage, microBatch, stashes[microBatch.index]);
+				stage.busySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - busyStart).count();
+				if (!firstStage && !backwardQueues[stageIndex - 1]->push(std::move(microBatch)))
+				{
+					return;
+				}
+			}
+		}
+		auto busyStart = std::chrono::steady_clock::now();
+		flush(stage, batchEnd - batchBegin);
+		stage.busySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - busyStart).count();
+	}
+};
+/*
+ * Computes one layer's outputs from its inputs
+ */
+void PipelineTrainer::propagate(const unsigned long &layerIndex, const std::vector<long double> &inputs, std::vector<long double> &outputs)
+{
+	thread_local std::vector<double> activationScratch;
+	thread_local std::vector<float> precisionScratch;
+	auto &layer = network.layers[layerIndex];
+	auto neuronsSize = layer.neurons.size();
+	auto neuronsData = layer.neurons.data();
+	auto inputsSize = inputs.size();
+	auto inputsData = inputs.data();
+	outputs.resize(neuronsSize);
+	auto outputsData = outputs.data();
+	if (network.weightPrecision != Precision::Extended)
+	{
+		// Widen the packed weights to float and accumulate in float, as NeuralNetwork::feedforward does
+		precisionScratch.assign(inputs.begin(), inputs.end());
+		auto packedWeightsData = layer.packedWeights.data();
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+		{
+			long double inputValue = Precision::dot(packedWeightsData + neuronIndex * inputsSize, precisionScratch.data(), inputsSize, network.weightPrecision);
+			outputsData[neuronIndex] = inputValue + neuronsData[neuronIndex].bias;
+		}
+	}
+	else
+	{
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+		{
+			auto neuronWeightsData = neuronsData[neuronIndex].weights.data();
+			long double inputValue = 0;
+			for (unsigned long inputIndex = 0; inputIndex < inputsSize; inputIndex++)
+			{
+				inputValue += inputsData[inputIndex] * neuronWeightsData[inputIndex];
+			}
+			outputsData[neuronIndex] = inputValue + neuronsData[neuronIndex].bias;
+		}
+	}
+	if (network.outputMode == NeuralNetwork::SoftmaxCrossEntropy && layerIndex == network.layers.size() - 1)
+	{
+		if (network.activationAccuracy == NeuralNetwork::Exact)
+		{
+			Activations::softmax(NeuralNetwork::Exact, outputsData, neuronsSize);
+			return;
+		}
+		activationScratch.assign(outputs.begin(), outputs.end());
+		Activations::softmax(network.activationAccuracy, activationScratch.data(), neuronsSize);
+		outputs.assign(activationScratch.begin(), activationScratch.end());
+		return;
+	}
+	if (network.activationAccuracy == NeuralNetwork::Exact)
+	{
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+		{
+			outputsData[neuronIndex] = network.activation(outputsData[neuronIndex]);
+		}
+		return;
+	}
+	activationScratch.assign(outputs.begin(), outputs.end());
+	Activations::activate(network.activationType, network.activationAccuracy, activationScratch.data(), neuronsSize);
+	outputs.assign(activationScratch.begin(), activationScratch.end());
+};
+/*
+ */
+static void stashValues(PipelineTrainer::Stage &stage, const std::vector<long double> &values)
+{
+	stage.stashedValues += values.size();
+	stage.peakStashedValues = (std::max)(stage.peakStashedValues, stage.stashedValues);
+};
+/*
+ */
+static void releaseValues(PipelineTrainer::Stage &stage, std::vector<long double> &values)
+{
+	stage.stashedValues -= values.size();
+	values.clear();
+	values.shrink_to_fit();
+};
+/*
+ * Applies the stage's layers to every sample of the micro-batch. Position p of a sample's stash holds the input
+ * of the stage's p-th layer (the last one its output), only positions that are multiples of the checkpoint
+ * interval are kept for the backward pass
+ */
+void PipelineTrainer::forward(Stage &stage, MicroBatch &microBatch, std::vector<std::vector<long double>> &stash)
+{
+	NNPP_TRACE_SCOPE("stage forward", "pipeline", stage.layerBegin);
+	auto layersCount = stage.layerEnd - stage.layerBegin;
+	auto stashStride = layersCount + 1;
+	auto valuesSize = microBatch.values.size();
+	stash.resize(valuesSize * stashStride);
+	for (unsigned long sampleIndex = 0; sampleIndex < valuesSize; sampleIndex++)
+	{
+		auto stashData = stash.data() + sampleIndex * stashStride;
+		// Kept checkpoints are overwritten in place, so only count the ones filled for the first time
+		bool inputStashed = !stashData[0].empty();
+		stashData[0] = std::move(microBatch.values[sampleIndex]);
+		if (!inputStashed)
+		{
+			stashValues(stage, stashData[0]);
+		}
+		for (unsigned long position = 0; position < layersCount; position++)
+		{
+			bool outputStashed = !stashData[position + 1].empty();
+			propagate(stage.layerBegin + position, stashData[position], stashData[position + 1]);
+			if (!outputStashed)
+			{
+				stashValues(stage, stashData[position + 1]);
+			}
+			if (position % effectiveCheckpointInterval != 0)
+			{
+				releaseValues(stage, stashData[position]);
+			}
+		}
+		microBatch.values[sampleIndex] = stashData[layersCount];
+		if (layersCount % effectiveCheckpointInterval != 0)
+		{
+			releaseValues(stage, stashData[layersCount]);
+		}
+	}
+};
+/*
+ * Takes the errors of the stage's outputs, accumulates the weight and bias gradients of its layers and replaces
+ * them with the errors of the stage's inputs, computed with the weights of the forward pass. Segments between
+ * checkpoints are walked from the last one, recomputing the activations the forward pass dropped and dropping
+ * them again once the segment is done
+ */
+void PipelineTrainer::backward(Stage &stage, MicroBatch &microBatch, std::vector<std::vector<long double>> &stash)
+{
+	NNPP_TRACE_SCOPE("stage backward", "pipeline", stage.layerBegin);
+	thread_local std::vector<double> derivativesScratch;
+	thread_local std::vector<long double> gradients;
+	auto layersCount = stage.layerEnd - stage.layerBegin;
+	auto stashStride = layersCount + 1;
+	auto interval = effectiveCheckpointInterval;
+	auto valuesSize = microBatch.values.size();
+	for (unsigned long sampleIndex = 0; sampleIndex < valuesSize; sampleIndex++)
+	{
+		auto stashData = stash.data() + sampleIndex * stashStride;
+		auto errors = std::move(microBatch.values[sampleIndex]);
+		for (unsigned long segmentBegin = (layersCount - 1) / interval * interval;; segmentBegin -= interval)
+		{
+			auto segmentEnd = (std::min)(segmentBegin + interval, layersCount);
+			for (unsigned long position = segmentBegin; position < segmentEnd; position++)
+			{
+				if (stashData[position + 1].empty())
+				{
+					NNPP_TRACE_SCOPE("recompute layer", "pipeline", stage.layerBegin + position);
+					propagate(stage.layerBegin + position, stashData[position], stashData[position + 1]);
+					stashValues(stage, stashData[position + 1]);
+				}
+			}
+			for (unsigned long layerIndex = stage.layerBegin + segmentEnd; layerIndex-- > stage.layerBegin + segmentBegin;)
+			{
+				auto &inputs = stashData[layerIndex - stage.layerBegin];
+				auto &outputs = stashData[layerIndex - stage.layerBegin + 1];
+				auto &layer = network.layers[layerIndex];
+				auto neuronsSize = layer.neurons.size();
+				auto neuronsData = layer.neurons.data();
+				auto inputsSize = inputs.size();
+				auto inputsData = inputs.data();
+				gradients.resize(neuronsSize);
+				auto gradientsData = gradients.data();
+				if (network.outputMode == NeuralNetwork::SoftmaxCrossEntropy && layerIndex == network.layers.size() - 1)
+				{
+					std::copy_n(errors.begin(), neuronsSize, gradientsData);
+				}
+				else if (network.activationAccuracy == NeuralNetwork::Exact)
+				{
+					for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+					{
+						gradientsData[neuronIndex] = errors[neuronIndex] * network.derivative(outputs[neuronIndex]);
+					}
+				}
+				else
+				{
+					derivativesScratch.assign(outputs.begin(), outputs.end());
+					Activations::differentiate(network.activationType, network.activationAccuracy, derivativesScratch.data(), neuronsSize);
+					for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+					{
+						gradientsData[neuronIndex] = errors[neuronIndex] * derivativesScratch[neuronIndex];
+					}
+				}
+				// The input layer has no gradient
+				bool propagateError = layerIndex > 1;
+				errors.assign(propagateError ? inputsSize : 0, 0);
+				auto errorsData = errors.data();
+				auto weightGradientsData = stage.weightGradients[layerIndex - stage.layerBegin].data();
+				auto biasGradientsData = stage.biasGradients[layerIndex - stage.layerBegin].data();
+				auto precision = network.weightPrecision;
+				auto packedWeightsData = layer.packedWeights.data();
+				for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+				{
+					auto neuronWeightsData = neuronsData[neuronIndex].weights.data();
+					auto packedRowData = packedWeightsData + neuronIndex * inputsSize;
+					auto weightGradientsRowData = weightGradientsData + neuronIndex * inputsSize;
+					long double gradient = gradientsData[neuronIndex];
+					biasGradientsData[neuronIndex] += gradient;
+					for (unsigned long inputIndex = 0; inputIndex < inputsSize; inputIndex++)
+					{
+						weightGradientsRowData[inputIndex] += gradient * inputsData[inputIndex];
+					}
+					if (propagateError && precision != Precision::Extended)
+					{
+						for (unsigned long inputIndex = 0; inputIndex < inputsSize; inputIndex++)
+						{
+							errorsData[inputIndex] += Precision::widen(packedRowData[inputIndex], precision) * gradient;
+						}
+					}
+					else if (propagateError)
+					{
+						for (unsigned long inputIndex = 0; inputIndex < inputsSize; inputIndex++)
+						{
+							errorsData[inputIndex] += neuronWeightsData[inputIndex] * gradient;
+						}
+					}
+				}
+			}
+			for (unsigned long position = segmentBegin + 1; position <= segmentEnd; position++)
+			{
+				if (position % interval != 0)
+				{
+					releaseValues(stage, stashData[position]);
+				}
+			}
+			if (segmentBegin == 0)
+			{
+				break;
+			}
+		}
+		microBatch.values[sampleIndex] = std::move(errors);
+	}
+};
+/*
+ * Applies the mean of the accumulated gradients to the stage's layers and clears them
+ */
+void PipelineTrainer::flush(Stage &stage, const unsigned long &samplesCount)
+{
+	NNPP_TRACE_SCOPE("stage flush", "pipeline", stage.layerBegin);
+	long double scale = network.learningRate / samplesCount;
+	for (unsigned long layerIndex = stage.layerBegin; layerIndex < stage.layerEnd; layerIndex++)
+	{
+		auto &layer = network.layers[layerIndex];
+		auto neuronsSize = layer.neurons.size();
+		auto neuronsData = layer.neurons.data();
+		auto &weightGradients = stage.weightGradients[layerIndex - stage.layerBegin];
+		auto &biasGradients = stage.biasGradients[layerIndex - stage.layerBegin];
+		auto inputsSize = layer.inputsSize();
+		for (unsigned long neuronIndex = 0; neuronIndex < neuronsSize; neuronIndex++)
+		{
+			auto &neuron = neuronsData[neuronIndex];
+			auto weightGradientsRowData = weightGradients.data() + neuronIndex * inputsSize;
+			if (layer.weightPrecision == Precision::Extended)
+			{
+				auto neuronWeightsData = neuron.weights.data();
+				for (unsigned long inputIndex = 0; inputIndex < inputsSize; inputIndex++)
+				{
+					neuronWeightsData[inputIndex] += scale * weightGradientsRowData[inputIndex];
+				}
+			}
+			else
+			{
+				// Updates the master weights when kept and repacks, otherwise the packed weights directly
+				for (unsigned long inputIndex = 0; inputIndex < inputsSize; inputIndex++)
+				{
+					layer.setWeight(neuronIndex, inputIndex, layer.weight(neuronIndex, inputIndex) + scale * weightGradientsRowData[inputIndex]);
+				}
+			}
+			neuron.bias += scale * biasGradients[neuronIndex];
+		}
+		std::fill(weightGradients.begin(), weightGradients.end(), 0);
+		std::fill(biasGradients.begin(), biasGradients.end(), 0);
+	}
+	network.parametersVersion++;
+};
+/*
+ */
+const std::vector<PipelineTrainer::StageStatistics> PipelineTrainer::statistics() const
+{
+	std::vector<StageStatistics> result;
+	for (auto &stage : stages)
+	{
+		StageStatistics stageStatistics;
+		stageStatistics.layerBegin = stage.layerBegin;
+		stageStatistics.layerEnd = stage.layerEnd;
+		stageStatistics.peakActivationBytes = stage.peakStashedValues * sizeof(long double);
+		stageStatistics.busySeconds = stage.busySeconds;
+		stageStatistics.utilisation = elapsedSeconds > 0 ? (std::min)(1.0, stage.busySeconds / elapsedSeconds) : 0;
+		result.push_back(stageStatistics);
+	}
+	return result;
+};
+/*
+ * Estimated activation memory of all stages with samplesCount samples in flight: the kept checkpoints of every
+ * sample plus one segment being recomputed
+ */
+const unsigned long PipelineTrainer::activationBytes(const unsigned long &interval, const unsigned long &samplesCount) const
+{
+	auto checkpointInterval = (std::max)(1ul, interval);
+	unsigned long values = 0;
+	for (auto &stage : stages)
+	{
+		auto layersCount = stage.layerEnd - stage.layerBegin;
+		unsigned long checkpointValues = 0;
+		unsigned long segmentValues = 0;
+		unsigned long largestSegmentValues = 0;
+		for (unsigned long position = 0; position <= layersCount; position++)
+		{
+			auto positionSize = network.layers[stage.layerBegin + position - 1].neurons.size();
+			if (position % checkpointInterval == 0)
+			{
+				checkpointValues += positionSize;
+				segmentValues = 0;
+				continue;
+			}
+			segmentValues += positionSize;
+			largestSegmentValues = (std::max)(largestSegmentValues, segmentValues);
+		}
+		values += samplesCount * checkpointValues + largestSegmentValues;
+	}
+	return values * sizeof(long double);
+};
+/*
+ * The smallest interval that fits memoryBudget, or the one using the least memory when none does
+ */
+const unsigned long PipelineTrainer::chooseCheckpointInterval(const unsigned long &samplesCount) const
+{
+	unsigned long longestStage = 1;
+	for (auto &stage : stages)
+	{
+		longestStage = (std::max)(longestStage, stage.layerEnd - stage.layerBegin);
+	}
+	unsigned long smallestInterval = 1;
+	unsigned long smallestBytes = activationBytes(1, samplesCount);
+	for (unsigned long interval = 1; interval <= longestStage + 1; interval++)
+	{
+		auto bytes = activationBytes(interval, samplesCount);
+		if (bytes <= memoryBudget)
+		{
+			return interval;
+		}
+		if (bytes < smallestBytes)
+		{
+			smallestInterval = interval;
+			smallestBytes = bytes;
+		}
+	}
+	return smallestInterval;
+};
+/*
+ */
@@ -0,0 +1,107 @@
+/*
+ */
+#include <PopulationTrainer.hpp>
+#include <algorithm>
+#include <exception>
+#include <mutex>
+using namespace nnpp;
+/*
+ */
+const long double PopulationTrainer::meanSquaredError(NeuralNetwork &network, const Dataset &dataset)
+{
+	return network.evaluate(dataset, NeuralNetwork::MeanSquaredError).meanSquaredError;
+};
+/*
+ */
+const std::vector<PopulationTrainer::Result> PopulationTrainer::train(const std::vector<Job> &jobs)
+{
+	auto &pool = executor ? *executor : Executor::shared();
+	auto jobsSize = jobs.size();
+	std::vector<Result> results(jobsSize);
+	std::vector<unsigned long> active;
+	unsigned long maximumEpochs = 0;
+	for (unsigned long jobIndex = 0; jobIndex < jobsSize; jobIndex++)
+	{
+		results[jobIndex].network = jobs[jobIndex].network;
+		active.push_back(jobIndex);
+		maximumEpochs = (std::max)(maximumEpochs, jobs[jobIndex].epochs);
+	}
+	// The first exception of a rung's jobs, rethrown once all of them have finished
+	std::mutex exceptionMutex;
+	std::exception_ptr exception;
+	bool halving = reductionFactor >= 2;
+	unsigned long budget = halving ? (std::max)(1ul, minimumEpochs) : maximumEpochs;
+	while (!active.empty())
+	{
+		std::atomic<unsigned long> remaining = active.size();
+		for (auto jobIndex : active)
+		{
+			pool.submit([&, jobIndex, budget]
+			{
+				try
+				{
+					auto &job = jobs[jobIndex];
+					auto &result = results[jobIndex];
+					auto &network = *job.network;
+					auto &trainingSet = *job.trainingSet;
+					auto trainingSetSize = trainingSet.size();
+					auto targetEpochs = (std::min)(budget, job.epochs);
+					for (; result.epochsTrained < targetEpochs; result.epochsTrained++)
+					{
+						for (unsigned long sampleIndex = 0; sampleIndex < trainingSetSize; sampleIndex++)
+						{
+							network.feedforward(trainingSet.inputs[sampleIndex]);
+							network.backpropagate(trainingSet.outputs[sampleIndex]);
+						}
+					}
+					result.loss = meanSquaredError(network, job.validationSet ? *job.validationSet : trainingSet);
+					result.rungsCompleted++;
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(exceptionMutex);
+					if (!exception)
+					{
+						exception = std::current_exception();
+					}
+				}
+				if (--remaining == 0)
+				{
+					pool.notifyCompletion();
+				}
+			});
+		}
+		pool.wait(remaining);
+		if (exception)
+		{
+			std::rethrow_exception(exception);
+		}
+		// Jobs that used up their own epochs are finished, the rest compete for the next rung
+		std::vector<unsigned long> unfinished;
+		for (auto jobIndex : active)
+		{
+			if (results[jobIndex].epochsTrained < jobs[jobIndex].epochs)
+			{
+				unfinished.push_back(jobIndex);
+			}
+		}
+		if (halving && unfinished.size() > 1)
+		{
+			std::sort(unfinished.begin(), unfinished.end(), [&](const unsigned long &left, const unsigned long &right)
+			{
+				return results[left].loss < results[right].loss;
+			});
+			auto survivors = (unfinished.size() + reductionFactor - 1) / reductionFactor;
+			for (auto iterator = unfinished.begin() + survivors; iterator != unfinished.end(); ++iterator)
+			{
+				results[*iterator].terminated = true;
+			}
+			unfinished.resize(survivors);
+		}
+		active = std::move(unfinished);
+		budget *= halving ? reductionFactor : 1;
+	}
+	return results;
+};
+/*
+ */
@@ -0,0 +1,187 @@
+/*
+ */
+#include <Precision.hpp>
+#include <bit>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define NNPP_X86_DISPATCH
+#endif
+using namespace nnpp;
+/*
+ */
+const uint16_t Precision::toHalf(const float &value)
+{
+	uint32_t bits = std::bit_cast<uint32_t>(value);
+	uint32_t sign = (bits >> 16) & 0x8000;
+	uint32_t exponent = (bits >> 23) & 0xff;
+	uint32_t mantissa = bits & 0x7fffff;
+	if (exponent == 0xff)
+	{
+		return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+	}
+	int halfExponent = (int)exponent - 127 + 15;
+	if (halfExponent >= 0x1f)
+	{
+		return sign | 0x7c00;
+	}
+	if (halfExponent <= 0)
+	{
+		if (halfExponent < -10)
+		{
+			return sign;
+		}
+		mantissa |= 0x800000;
+		uint32_t shift = 14 - halfExponent;
+		uint32_t half = mantissa >> shift;
+		uint32_t remainder = mantissa & ((1u << shift) - 1);
+		uint32_t halfway = 1u << (shift - 1);
+		if (remainder > halfway || (remainder == halfway && (half & 1)))
+		{
+			half++;
+		}
+		return sign | half;
+	}
+	uint32_t half = ((uint32_t)halfExponent << 10) | (mantissa >> 13);
+	uint32_t remainder = mantissa & 0x1fff;
+	if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+	{
+		// A carry out of the mantissa correctly bumps the exponent, up to infinity
+		half++;
+	}
+	return sign | half;
+};
+/*
+ */
+const float Precision::fromHalf(const uint16_t &value)
+{
+	uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+	uint32_t exponent = (value >> 10) & 0x1f;
+	uint32_t mantissa = value & 0x3ff;
+	if (exponent == 0)
+	{
+		if (mantissa == 0)
+		{
+			return std::bit_cast<float>(sign);
+		}
+		int normalizedExponent = 1;
+		while (!(mantissa & 0x400))
+		{
+			mantissa <<= 1;
+			normalizedExponent--;
+		}
+		mantissa &= 0x3ff;
+		return std::bit_cast<float>(sign | ((uint32_t)(normalizedExponent + 127 - 15) << 23) | (mantissa << 13));
+	}
+	if (exponent == 0x1f)
+	{
+		return std::bit_cast<float>(sign | 0x7f800000 | (mantissa << 13));
+	}
+	return std::bit_cast<float>(sign | ((exponent + 127 - 15) << 23) | (mantissa << 13));
+};
+/*
+ */
+const uint16_t Precision::toBFloat16(const float &value)
+{
+	uint32_t bits = std::bit_cast<uint32_t>(value);
+	if ((bits & 0x7fffffff) > 0x7f800000)
+	{
+		return (bits >> 16) | 0x40;
+	}
+	return (bits + 0x7fff + ((bits >> 16) & 1)) >> 16;
+};
+/*
+ */
+const float Precision::fromBFloat16(const uint16_t &value)
+{
+	return std::bit_cast<float>((uint32_t)value << 16);
+};
+/*
+ */
+const uint16_t Precision::narrow(const float &value, const Type &precision)
+{
+	return precision == BFloat16 ? toBFloat16(value) : toHalf(value);
+};
+/*
+ */
+const float Precision::widen(const uint16_t &value, const Type &precision)
+{
+	return precision == BFloat16 ? fromBFloat16(value) : fromHalf(value);
+};
+/*
+ */
+#ifdef NNPP_X86_DISPATCH
+__attribute__((target("avx,f16c,fma")))
+static float dotHalfF16C(const uint16_t *weights, const float *values, const unsigned long &size)
+{
+	__m256 accumulator = _mm256_setzero_ps();
+	unsigned long index = 0;
+	for (; index + 8 <= size; index += 8)
+	{
+		__m256 widened = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(weights + index)));
+		accumulator = _mm256_fmadd_ps(widened, _mm256_loadu_ps(values + index), accumulator);
+	}
+	float lanes[8];
+	_mm256_storeu_ps(lanes, accumulator);
+	float sum = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+	for (; index < size; index++)
+	{
+		sum += Precision::fromHalf(weights[index]) * values[index];
+	}
+	return sum;
+};
+/*
+ */
+__attribute__((target("avx2,fma")))
+static float dotBFloat16AVX2(const uint16_t *weights, const float *values, const unsigned long &size)
+{
+	__m256 accumulator = _mm256_setzero_ps();
+	unsigned long index = 0;
+	for (; index + 8 <= size; index += 8)
+	{
+		__m256i extended = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(weights + index)));
+		__m256 widened = _mm256_castsi256_ps(_mm256_slli_epi32(extended, 16));
+		accumulator = _mm256_fmadd_ps(widened, _mm256_loadu_ps(values + index), accumulator);
+	}
+	float lanes[8];
+	_mm256_storeu_ps(lanes, accumulator);
+	float sum = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+	for (; index < size; index++)
+	{
+		sum += Precision::fromBFloat16(weights[index]) * values[index];
+	}
+	return sum;
+};
+#endif
+/*
+ */
+const float Precision::dot(const uint16_t *weights, const float *values, const unsigned long &size, const Type &precision)
+{
+#ifdef NNPP_X86_DISPATCH
+	static const bool hasF16C = __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c") && __builtin_cpu_supports("fma");
+	static const bool hasAVX2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	if (precision == Half && hasF16C)
+	{
+		return dotHalfF16C(weights, values, size);
+	}
+	if (precision == BFloat16 && hasAVX2)
+	{
+		return dotBFloat16AVX2(weights, values, size);
+	}
+#endif
+	float sum = 0;
+	if (precision == BFloat16)
+	{
+		for (unsigned long index = 0; index < size; index++)
+		{
+			sum += fromBFloat16(weights[index]) * values[index];
+		}
+		return sum;
+	}
+	for (unsigned long index = 0; index < size; index++)
+	{
+		sum += fromHalf(weights[index]) * values[index];
+	}
+	return sum;
+};
+/*
+ */
@@ -0,0 +1,221 @@
+/*
+ */
+#include <Rasterizer.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+using namespace nnpp;
+/*
+ */
+// clang-format off
+static const uint16_t font5x3[] = {0x0000,0x2092,0x002d,0x5f7d,0x279e,0x52a5,0x7ad6,0x0012,0x4494,0x1491,0x017a,0x05d0,0x1400,0x01c0,0x0400,0x12a4,0x2b6a,0x749a,0x752a,0x38a3,0x4f4a,0x38cf,0x3bce,0x12a7,0x3aae,0x49ae,0x0410,0x1410,0x4454,0x0e38,0x1511,0x10e3,0x73ee,0x5f7a,0x3beb,0x624e,0x3b6b,0x73cf,0x13cf,0x6b4e,0x5bed,0x7497,0x2b27,0x5add,0x7249,0x5b7d,0x5b6b,0x3b6e,0x12eb,0x4f6b,0x5aeb,0x388e,0x2497,0x6b6d,0x256d,0x5f6d,0x5aad,0x24ad,0x72a7,0x6496,0x4889,0x3493,0x002a,0xf000,0x0011,0x6b98,0x3b79,0x7270,0x7b74,0x6750,0x95d6,0xb9ee,0x5b59,0x6410,0xb482,0x56e8,0x6492,0x5be8,0x5b58,0x3b70,0x976a,0xcd6a,0x1370,0x38f0,0x64ba,0x3b68,0x2568,0x5f68,0x54a8,0xb9ad,0x73b8,0x64d6,0x2492,0x3593,0x03e0};
+// clang-format on
+/*
+ */
+Rasterizer::Rasterizer(uint32_t *pixels, const int &width, const int &height):
+	pixels(pixels),
+	width(width),
+	height(height)
+{
+};
+/*
+ */
+void Rasterizer::span(const int &y, int x0, int x1, const uint32_t &color)
+{
+	if (y < 0 || y >= height)
+	{
+		return;
+	}
+	x0 = (std::max)(x0, 0);
+	x1 = (std::min)(x1, width - 1);
+	if (x0 > x1)
+	{
+		return;
+	}
+	std::fill_n(pixels + (long)y * width + x0, x1 - x0 + 1, color);
+};
+/*
+ */
+void Rasterizer::clear(const uint32_t &color)
+{
+	std::fill_n(pixels, (long)width * height, color);
+};
+/*
+ */
+void Rasterizer::rect(const int &x, const int &y, const int &w, const int &h, const uint32_t &color)
+{
+	auto rowEnd = (std::min)(y + h, height);
+	for (int row = (std::max)(y, 0); row < rowEnd; row++)
+	{
+		span(row, x, x + w - 1, color);
+	}
+};
+/*
+ * One span per row, its half width shrinks monotonically from the center row outwards
+ */
+void Rasterizer::circle(const int &x, const int &y, const int &radius, const uint32_t &color)
+{
+	if (radius < 0)
+	{
+		return;
+	}
+	long halfWidth = radius;
+	long radiusSquared = (long)radius * radius;
+	for (long dy = 0; dy <= radius; dy++)
+	{
+		while (halfWidth * halfWidth + dy * dy > radiusSquared)
+		{
+			halfWidth--;
+		}
+		span(y + dy, x - halfWidth, x + halfWidth, color);
+		if (dy)
+		{
+			span(y - dy, x - halfWidth, x + halfWidth, color);
+		}
+	}
+};
+/*
+ * Lines entirely on one side of the buffer are rejected and lines entirely inside it are drawn unchecked. Others
+ * are stepped with bounds checks and stop once they leave the buffer, keeping the exact pixels of the unclipped
+ * line.
+ */
+void Rasterizer::line(int x0, int y0, const int &x1, const int &y1, const uint32_t &color)
+{
+	auto outcode = [this](const int &x, const int &y)
+	{
+		return (x < 0) | (x >= width) << 1 | (y < 0) << 2 | (y >= height) << 3;
+	};
+	auto startCode = outcode(x0, y0);
+	auto endCode = outcode(x1, y1);
+	if (startCode & endCode)
+	{
+		return;
+	}
+	if (y0 == y1)
+	{
+		span(y0, (std::min)(x0, x1), (std::max)(x0, x1), color);
+		return;
+	}
+	auto inside = !(startCode | endCode);
+	int dx = std::abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+	int dy = std::abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+	int error = (dx > dy ? dx : -dy) / 2;
+	bool entered = false;
+	while (true)
+	{
+		if (inside || contains(x0, y0))
+		{
+			pixels[(long)y0 * width + x0] = color;
+			entered = true;
+		}
+		else if (entered)
+		{
+			return;
+		}
+		if (x0 == x1 && y0 == y1)
+		{
+			return;
+		}
+		auto previousError = error;
+		if (previousError > -dx)
+		{
+			error -= dy;
+			x0 += sx;
+		}
+		if (previousError < dy)
+		{
+			error += dx;
+			y0 += sy;
+		}
+	}
+};
+/*
+ * Scanline flood fill with an explicit stack of seeds: each seed is widened to its whole run of the old color,
+ * which is filled as one span, and one seed is pushed per run of the old color directly above and below it
+ */
+void Rasterizer::fill(const int &x, const int &y, const uint32_t &color)
+{
+	if (!contains(x, y))
+	{
+		return;
+	}
+	auto old = pixel(x, y);
+	if (old == color)
+	{
+		return;
+	}
+	std::vector<std::pair<int, int>> seeds = {{x, y}};
+	while (!seeds.empty())
+	{
+		auto [seedX, seedY] = seeds.back();
+		seeds.pop_back();
+		auto row = pixels + (long)seedY * width;
+		if (row[seedX] != old)
+		{
+			continue;
+		}
+		int left = seedX;
+		int right = seedX;
+		while (left > 0 && row[left - 1] == old)
+		{
+			left--;
+		}
+		while (right < width - 1 && row[right + 1] == old)
+		{
+			right++;
+		}
+		std::fill_n(row + left, right - left + 1, color);
+		for (auto neighbourY : {seedY - 1, seedY + 1})
+		{
+			if (neighbourY < 0 || neighbourY >= height)
+			{
+				continue;
+			}
+			auto neighbourRow = pixels + (long)neighbourY * width;
+			for (int neighbourX = left; neighbourX <= right; neighbourX++)
+			{
+				if (neighbourRow[neighbourX] == old && (neighbourX == left || neighbourRow[neighbourX - 1] != old))
+				{
+					seeds.emplace_back(neighbourX, neighbourY);
+				}
+			}
+		}
+	}
+};
+/*
+ */
+void Rasterizer::text(int x, const int &y, const std::string &string, const int &scale, const uint32_t &color)
+{
+	for (auto character : string)
+	{
+		if (character > 32 && character < 32 + (int)(sizeof(font5x3) / sizeof(font5x3[0])))
+		{
+			auto bitmap = font5x3[character - 32];
+			for (int dy = 0; dy < 5; dy++)
+			{
+				for (int dx = 0; dx < 3; dx++)
+				{
+					if (bitmap >> (dy * 3 + dx) & 1)
+					{
+						rect(x + dx * scale, y + dy * scale, scale, scale, color);
+					}
+				}
+			}
+		}
+		x += 4 * scale;
+	}
+};
+/*
+ */
+const bool Rasterizer::contains(const int &x, const int &y) const
+{
+	return x >= 0 && y >= 0 && x < width && y < height;
+};
+/*
+ */
+const uint32_t Rasterizer::pixel(const int &x, const int &y) const
+{
+	return pixels[(long)y * width + x];
+};
+/*
+ */
@@ -0,0 +1,74 @@
+/*
+ */
+#include <ReplicaSet.hpp>
+#include <Numa.hpp>
+#include <exception>
+#include <thread>
+using namespace nnpp;
+/*
+ */
+ReplicaSet::ReplicaSet(const NeuralNetwork &network, const bool &replicatePerNode, const bool &hugePages):
+	replicatePerNode(replicatePerNode),
+	hugePages(hugePages)
+{
+	refresh(network);
+};
+/*
+ */
+void ReplicaSet::refresh(const NeuralNetwork &network)
+{
+	auto nodeCount = replicatePerNode ? Numa::nodeCount() : 1;
+	std::vector<std::unique_ptr<PackedNetwork>> newReplicas(nodeCount);
+	std::vector<std::exception_ptr> exceptions(nodeCount);
+	// The builders count against the core budget while they run
+	Executor::CoreReservation buildersCores(nodeCount);
+	std::vector<std::thread> builders;
+	for (unsigned long node = 0; node < nodeCount; node++)
+	{
+		builders.emplace_back([&, node]
+		{
+			try
+			{
+				Numa::pinThreadToNode(node);
+				newReplicas[node] = std::make_unique<PackedNetwork>(network, hugePages);
+			}
+			catch (...)
+			{
+				exceptions[node] = std::current_exception();
+			}
+		});
+	}
+	for (auto &builder : builders)
+	{
+		builder.join();
+	}
+	// The current replicas stay in place when any node fails
+	for (auto &exception : exceptions)
+	{
+		if (exception)
+		{
+			std::rethrow_exception(exception);
+		}
+	}
+	replicas = std::move(newReplicas);
+};
+/*
+ */
+const PackedNetwork &ReplicaSet::replica(const unsigned long &node) const
+{
+	return *replicas[node < replicas.size() ? node : 0];
+};
+/*
+ */
+const PackedNetwork &ReplicaSet::local() const
+{
+	return replica(Numa::currentNode());
+};
+/*
+ */
+const std::vector<long double> ReplicaSet::predict(const std::vector<long double> &inputValues) const
+{
+	return local().predict(inputValues);
+};
+/*
+ */
@@ -0,0 +1,197 @@
+/*
+ */
+#include <SharedMemoryTransport.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace nnpp;
+/*
+ */
+struct SharedHeader
+{
+	std::atomic<unsigned long> ready;
+	unsigned long job;
+	unsigned long broadcastSize;
+	pthread_barrier_t barrier;
+};
+static const unsigned long headerSize = (sizeof(SharedHeader) + 63) / 64 * 64;
+static const unsigned long readyMagic = 0x5a6575726f6e;
+static const auto attachTimeout = std::chrono::seconds(30);
+/*
+ */
+SharedMemoryTransport::SharedMemoryTransport(const std::string &name, const unsigned long &rank, const unsigned long &worldSize, const unsigned long &job, const unsigned long &capacity):
+	name(name),
+	rankIndex(rank),
+	ranksCount(worldSize),
+	capacity((capacity + 63) / 64 * 64)
+{
+	if (worldSize == 0 || rank >= worldSize)
+	{
+		throw std::runtime_error("SharedMemoryTransport: rank must be below the world size");
+	}
+	mappingSize = headerSize + this->capacity * worldSize;
+	auto deadline = std::chrono::steady_clock::now() + attachTimeout;
+	if (rank == 0)
+	{
+		// Drop a segment left behind by a crashed job
+		shm_unlink(name.c_str());
+		auto descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+		if (descriptor < 0 || ftruncate(descriptor, mappingSize) != 0)
+		{
+			throw std::runtime_error("SharedMemoryTransport: unable to create " + name + ": " + std::strerror(errno));
+		}
+		map(descriptor);
+		auto header = (SharedHeader *)mapping;
+		pthread_barrierattr_t attributes;
+		pthread_barrierattr_init(&attributes);
+		pthread_barrierattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+		pthread_barrier_init(&header->barrier, &attributes, worldSize);
+		pthread_barrierattr_destroy(&attributes);
+		header->job = job;
+		header->ready.store(readyMagic, std::memory_order_release);
+	}
+	else
+	{
+		// Wait for rank 0 to create and initialise the segment of this job. A segment left behind by a crashed job
+		// is mapped, found to belong to another job and reopened until rank 0 has replaced it
+		while (true)
+		{
+			struct stat status = {};
+			auto descriptor = shm_open(name.c_str(), O_RDWR, 0600);
+			if (descriptor >= 0 && fstat(descriptor, &status) == 0 && (unsigned long)status.st_size == mappingSize)
+			{
+				map(descriptor);
+				auto header = (SharedHeader *)mapping;
+				if (header->ready.load(std::memory_order_acquire) == readyMagic && header->job == job)
+				{
+					break;
+				}
+				munmap(mapping, mappingSize);
+				mapping = 0;
+			}
+			else if (descriptor >= 0)
+			{
+				close(descriptor);
+			}
+			if (std::chrono::steady_clock::now() > deadline)
+			{
+				throw std::runtime_error("SharedMemoryTransport: timed out waiting for " + name);
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+	barrier();
+	if (rank == 0)
+	{
+		shm_unlink(name.c_str());
+	}
+};
+/*
+ */
+SharedMemoryTransport::~SharedMemoryTransport()
+{
+	if (mapping)
+	{
+		munmap(mapping, mappingSize);
+	}
+};
+/*
+ * Maps the segment and closes descriptor
+ */
+void SharedMemoryTransport::map(const int &descriptor)
+{
+	mapping = mmap(0, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+	close(descriptor);
+	if (mapping == MAP_FAILED)
+	{
+		mapping = 0;
+		throw std::runtime_error("SharedMemoryTransport: unable to map " + name + ": " + std::strerror(errno));
+	}
+};
+/*
+ */
+const unsigned long SharedMemoryTransport::rank() const
+{
+	return rankIndex;
+};
+/*
+ */
+const unsigned long SharedMemoryTransport::worldSize() const
+{
+	return ranksCount;
+};
+/*
+ */
+void SharedMemoryTransport::barrier()
+{
+	pthread_barrier_wait(&((SharedHeader *)mapping)->barrier);
+};
+/*
+ */
+char *SharedMemoryTransport::slot(const unsigned long &rank) const
+{
+	return (char *)mapping + headerSize + rank * capacity;
+};
+/*
+ */
+void SharedMemoryTransport::allReduce(std::vector<long double> &values)
+{
+	auto valuesSize = values.size();
+	if (valuesSize * sizeof(long double) > capacity)
+	{
+		throw std::runtime_error("SharedMemoryTransport: values exceed the slot capacity");
+	}
+	std::memcpy(slot(rankIndex), values.data(), valuesSize * sizeof(long double));
+	barrier();
+	// Each rank sums its own segment of every slot into slot 0
+	auto segmentBegin = valuesSize * rankIndex / ranksCount;
+	auto segmentEnd = valuesSize * (rankIndex + 1) / ranksCount;
+	auto sumsData = (long double *)slot(0);
+	for (unsigned long rank = 1; rank < ranksCount; rank++)
+	{
+		auto slotData = (const long double *)slot(rank);
+		for (unsigned long valueIndex = segmentBegin; valueIndex < segmentEnd; valueIndex++)
+		{
+			sumsData[valueIndex] += slotData[valueIndex];
+		}
+	}
+	barrier();
+	std::memcpy(values.data(), sumsData, valuesSize * sizeof(long double));
+	// Nobody may overwrite slot 0 before every rank has read it
+	barrier();
+};
+/*
+ */
+void SharedMemoryTransport::broadcast(std::vector<char> &bytes)
+{
+	auto header = (SharedHeader *)mapping;
+	if (rankIndex == 0)
+	{
+		header->broadcastSize = bytes.size();
+		if (bytes.size() <= capacity)
+		{
+			std::memcpy(slot(0), bytes.data(), bytes.size());
+		}
+	}
+	barrier();
+	auto broadcastSize = header->broadcastSize;
+	if (broadcastSize > capacity)
+	{
+		barrier();
+		throw std::runtime_error("SharedMemoryTransport: broadcast exceeds the slot capacity");
+	}
+	if (rankIndex != 0)
+	{
+		bytes.assign(slot(0), slot(0) + broadcastSize);
+	}
+	barrier();
+};
+/*
+ */
@@ -0,0 +1,247 @@
+/*
+ */
+#include <TcpTransport.hpp>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using namespace nnpp;
+/*
+ */
+static void throwSystemError(const std::string &message)
+{
+	throw std::runtime_error("TcpTransport: " + message + ": " + std::strerror(errno));
+};
+/*
+ */
+static void disableDelay(const int &socket)
+{
+	int enabled = 1;
+	setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+};
+/*
+ */
+TcpTransport::TcpTransport(const std::string &host, const unsigned short &port, const unsigned long &rank, const unsigned long &worldSize, const unsigned long &timeoutMilliseconds):
+	rankIndex(rank),
+	ranksCount(worldSize)
+{
+	if (worldSize == 0 || rank >= worldSize)
+	{
+		throw std::runtime_error("TcpTransport: rank must be below the world size");
+	}
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMilliseconds);
+	if (rank == 0)
+	{
+		sockets.assign(worldSize, -1);
+		if (worldSize == 1)
+		{
+			return;
+		}
+		int listener = socket(AF_INET, SOCK_STREAM, 0);
+		if (listener < 0)
+		{
+			throwSystemError("socket");
+		}
+		int enabled = 1;
+		setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled));
+		sockaddr_in address = {};
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_ANY);
+		address.sin_port = htons(port);
+		if (bind(listener, (sockaddr *)&address, sizeof(address)) != 0 || listen(listener, (int)worldSize) != 0)
+		{
+			close(listener);
+			throwSystemError("unable to listen on port " + std::to_string(port));
+		}
+		for (unsigned long connected = 1; connected < worldSize; connected++)
+		{
+			auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+			pollfd pollDescriptor = {listener, POLLIN, 0};
+			if (remaining <= 0 || poll(&pollDescriptor, 1, (int)remaining) <= 0)
+			{
+				close(listener);
+				throw std::runtime_error("TcpTransport: timed out waiting for the other ranks");
+			}
+			int connection = accept(listener, 0, 0);
+			if (connection < 0)
+			{
+				close(listener);
+				throwSystemError("accept");
+			}
+			disableDelay(connection);
+			unsigned long remoteRank = 0;
+			receiveAll(connection, &remoteRank, sizeof(remoteRank));
+			if (remoteRank == 0 || remoteRank >= worldSize || sockets[remoteRank] >= 0)
+			{
+				close(connection);
+				close(listener);
+				throw std::runtime_error("TcpTransport: invalid rank " + std::to_string(remoteRank) + " connected");
+			}
+			sockets[remoteRank] = connection;
+		}
+		close(listener);
+		return;
+	}
+	addrinfo hints = {};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	addrinfo *addresses = 0;
+	if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses) != 0)
+	{
+		throw std::runtime_error("TcpTransport: unable to resolve " + host);
+	}
+	// Rank 0 may not be listening yet, keep retrying until the deadline
+	int connection = -1;
+	while (connection < 0)
+	{
+		for (auto address = addresses; address && connection < 0; address = address->ai_next)
+		{
+			connection = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+			if (connection >= 0 && connect(connection, address->ai_addr, address->ai_addrlen) != 0)
+			{
+				close(connection);
+				connection = -1;
+			}
+		}
+		if (connection < 0)
+		{
+			if (std::chrono::steady_clock::now() > deadline)
+			{
+				freeaddrinfo(addresses);
+				throw std::runtime_error("TcpTransport: timed out connecting to " + host + ":" + std::to_string(port));
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+	}
+	freeaddrinfo(addresses);
+	disableDelay(connection);
+	sockets = {connection};
+	sendAll(connection, &rankIndex, sizeof(rankIndex));
+};
+/*
+ */
+TcpTransport::~TcpTransport()
+{
+	for (auto &socket : sockets)
+	{
+		if (socket >= 0)
+		{
+			close(socket);
+		}
+	}
+};
+/*
+ */
+const unsigned long TcpTransport::rank() const
+{
+	return rankIndex;
+};
+/*
+ */
+const unsigned long TcpTransport::worldSize() const
+{
+	return ranksCount;
+};
+/*
+ */
+void TcpTransport::sendAll(const int &socket, const void *data, const unsigned long &size)
+{
+	auto bytes = (const char *)data;
+	unsigned long sent = 0;
+	while (sent < size)
+	{
+		auto result = send(socket, bytes + sent, size - sent, MSG_NOSIGNAL);
+		if (result < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			throwSystemError("send");
+		}
+		sent += result;
+	}
+};
+/*
+ */
+void TcpTransport::receiveAll(const int &socket, void *data, const unsigned long &size)
+{
+	auto bytes = (char *)data;
+	unsigned long received = 0;
+	while (received < size)
+	{
+		auto result = recv(socket, bytes + received, size - received, 0);
+		if (result == 0)
+		{
+			throw std::runtime_error("TcpTransport: connection closed");
+		}
+		if (result < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			throwSystemError("recv");
+		}
+		received += result;
+	}
+};
+/*
+ */
+void TcpTransport::allReduce(std::vector<long double> &values)
+{
+	unsigned long valuesSize = values.size();
+	if (rankIndex != 0)
+	{
+		sendAll(sockets[0], &valuesSize, sizeof(valuesSize));
+		sendAll(sockets[0], values.data(), valuesSize * sizeof(long double));
+		receiveAll(sockets[0], values.data(), valuesSize * sizeof(long double));
+		return;
+	}
+	std::vector<long double> remoteValues(valuesSize);
+	for (unsigned long rank = 1; rank < ranksCount; rank++)
+	{
+		unsigned long remoteSize = 0;
+		receiveAll(sockets[rank], &remoteSize, sizeof(remoteSize));
+		if (remoteSize != valuesSize)
+		{
+			throw std::runtime_error("TcpTransport: rank " + std::to_string(rank) + " sent " + std::to_string(remoteSize) + " values, expected " + std::to_string(valuesSize));
+		}
+		receiveAll(sockets[rank], remoteValues.data(), valuesSize * sizeof(long double));
+		for (unsigned long valueIndex = 0; valueIndex < valuesSize; valueIndex++)
+		{
+			values[valueIndex] += remoteValues[valueIndex];
+		}
+	}
+	for (unsigned long rank = 1; rank < ranksCount; rank++)
+	{
+		sendAll(sockets[rank], values.data(), valuesSize * sizeof(long double));
+	}
+};
+/*
+ */
+void TcpTransport::broadcast(std::vector<char> &bytes)
+{
+	unsigned long bytesSize = bytes.size();
+	if (rankIndex != 0)
+	{
+		receiveAll(sockets[0], &bytesSize, sizeof(bytesSize));
+		bytes.resize(bytesSize);
+		receiveAll(sockets[0], bytes.data(), bytesSize);
+		return;
+	}
+	for (unsigned long rank = 1; rank < ranksCount; rank++)
+	{
+		sendAll(sockets[rank], &bytesSize, sizeof(bytesSize));
+		sendAll(sockets[rank], bytes.data(), bytesSize);
+	}
+};
+/*
+ */
@@ -0,0 +1,228 @@
+/*
+ */
+#include <Tracer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <ios>
+/*
+ */
+using namespace nnpp;
+std::atomic<bool> Tracer::enabled = false;
+static std::mutex buffersMutex;
+static std::vector<std::shared_ptr<Tracer::Buffer>> buffers;
+static unsigned long bufferCapacity = 1ul << 16;
+static std::atomic<unsigned long> generation = 0;
+static const auto epoch = std::chrono::steady_clock::now();
+/*
+ * Buffers are registered once per thread and per start, and stay registered after their thread exits so its
+ * spans can still be written
+ */
+static Tracer::Buffer &threadBuffer()
+{
+	thread_local std::shared_ptr<Tracer::Buffer> buffer;
+	thread_local unsigned long bufferGeneration = 0;
+	auto currentGeneration = generation.load(std::memory_order_acquire);
+	if (!buffer || bufferGeneration != currentGeneration)
+	{
+		std::lock_guard<std::mutex> lock(buffersMutex);
+		buffer = std::make_shared<Tracer::Buffer>();
+		buffer->slots = std::make_unique<Tracer::Slot[]>(bufferCapacity);
+		buffer->capacity = bufferCapacity;
+		buffer->threadIndex = buffers.size();
+		buffers.push_back(buffer);
+		bufferGeneration = currentGeneration;
+	}
+	return *buffer;
+};
+/*
+ */
+Tracer::Scope::Scope(const char *name, const char *category, const long &argument):
+	name(name),
+	category(category),
+	argument(argument),
+	active(enabled.load(std::memory_order_relaxed))
+{
+	if (active)
+	{
+		begin = now();
+	}
+};
+/*
+ */
+Tracer::Scope::~Scope()
+{
+	if (active)
+	{
+		record(name, category, begin, now(), argument);
+	}
+};
+/*
+ * Drops the spans of the previous session
+ */
+void Tracer::start(const unsigned long &eventsPerThread)
+{
+	{
+		std::lock_guard<std::mutex> lock(buffersMutex);
+		buffers.clear();
+		bufferCapacity = eventsPerThread ? eventsPerThread : 1;
+		generation.fetch_add(1, std::memory_order_release);
+	}
+	enabled = true;
+};
+/*
+ */
+void Tracer::stop()
+{
+	enabled = false;
+};
+/*
+ * Nanoseconds since the library was loaded
+ */
+const unsigned long Tracer::now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+};
+/*
+ */
+void Tracer::record(const char *name, const char *category, const unsigned long &begin, const unsigned long &end, const long &argument)
+{
+	if (!enabled.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+	auto &buffer = threadBuffer();
+	// Only the owning thread writes. The claim is ordered before the slot's stores by the release fence, so a
+	// reader that saw any of them also sees the claim, and the release store of head publishes the event.
+	auto head = buffer.head.load(std::memory_order_relaxed);
+	buffer.claimed.store(head + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	auto &slot = buffer.slots[head % buffer.capacity];
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.category.store(category, std::memory_order_relaxed);
+	slot.begin.store(begin, std::memory_order_relaxed);
+	slot.end.store(end, std::memory_order_relaxed);
+	slot.argument.store(argument, std::memory_order_relaxed);
+	buffer.head.store(head + 1, std::memory_order_release);
+};
+/*
+ * Locks mutex, recording a "mutex wait" span when it was held by another thread
+ */
+std::unique_lock<std::mutex> Tracer::lock(std::mutex &mutex)
+{
+	if (!enabled.load(std::memory_order_relaxed))
+	{
+		return std::unique_lock<std::mutex>(mutex);
+	}
+	std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+	if (!lock.owns_lock())
+	{
+		auto begin = now();
+		lock.lock();
+		record("mutex wait", "lock", begin, now());
+	}
+	return lock;
+};
+/*
+ * Spans the owning thread may have started overwriting while they were copied are dropped: the acquire fence
+ * orders the copies before the load of claimed, so any store the copies observed is covered by it
+ */
+static const std::vector<Tracer::Event> snapshot(Tracer::Buffer &buffer)
+{
+	auto capacity = buffer.capacity;
+	auto head = buffer.head.load(std::memory_order_acquire);
+	auto first = head > capacity ? head - capacity : 0;
+	std::vector<Tracer::Event> events;
+	for (auto index = first; index < head; index++)
+	{
+		auto &slot = buffer.slots[index % capacity];
+		events.push_back({slot.name.load(std::memory_order_relaxed), slot.category.load(std::memory_order_relaxed),
+			slot.begin.load(std::memory_order_relaxed), slot.end.load(std::memory_order_relaxed), slot.argument.load(std::memory_order_relaxed)});
+	}
+	std::atomic_thread_fence(std::memory_order_acquire);
+	auto claimed = buffer.claimed.load(std::memory_order_relaxed);
+	auto overwritten = claimed > capacity ? claimed - capacity : 0;
+	if (overwritten > first)
+	{
+		events.erase(events.begin(), events.begin() + (std::min)(overwritten - first, (unsigned long)events.size()));
+	}
+	return events;
+};
+/*
+ */
+const std::vector<Tracer::Event> Tracer::events()
+{
+	std::vector<Event> events;
+	std::lock_guard<std::mutex> lock(buffersMutex);
+	for (auto &buffer : buffers)
+	{
+		auto bufferEvents = snapshot(*buffer);
+		events.insert(events.end(), bufferEvents.begin(), bufferEvents.end());
+	}
+	return events;
+};
+/*
+ */
+static void writeString(std::ofstream &file, const char *string)
+{
+	file << '"';
+	for (; *string; string++)
+	{
+		if (*string == '"' || *string == '\\')
+		{
+			file << '\\';
+		}
+		file << *string;
+	}
+	file << '"';
+};
+/*
+ * Trace Event timestamps are in microseconds
+ */
+static void writeMicroseconds(std::ofstream &file, const unsigned long &nanoseconds)
+{
+	auto fraction = std::to_string(nanoseconds % 1000);
+	file << nanoseconds / 1000 << "." << std::string(3 - fraction.size(), '0') << fraction;
+};
+/*
+ * Safe while tracing runs, but call after stop to keep the spans recorded while writing
+ */
+void Tracer::write(const std::string &filename)
+{
+	std::ofstream file(filename);
+	if (!file.is_open())
+	{
+		throw std::ios_base::failure("Error: Unable to open file for writing.");
+	}
+	std::lock_guard<std::mutex> lock(buffersMutex);
+	file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	for (auto &buffer : buffers)
+	{
+		auto threadIndex = buffer->threadIndex;
+		file << (threadIndex ? "," : "") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadIndex
+			<< ",\"args\":{\"name\":\"thread " << threadIndex << "\"}}";
+		for (auto &event : snapshot(*buffer))
+		{
+			file << ",{\"name\":";
+			writeString(file, event.name);
+			file << ",\"cat\":";
+			writeString(file, event.category);
+			file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadIndex << ",\"ts\":";
+			writeMicroseconds(file, event.begin);
+			file << ",\"dur\":";
+			writeMicroseconds(file, event.end - event.begin);
+			if (event.argument >= 0)
+			{
+				file << ",\"args\":{\"layer\":" << event.argument << "}";
+			}
+			file << "}";
+		}
+	}
+	file << "]}\n";
+	if (!file)
+	{
+		throw std::ios_base::failure("Error: Writing to the file failed.");
+	}
+};
+/*
+ */
@@ -0,0 +1,120 @@
+/*
+ */
+#include <Activations.hpp>
+#include <Logger.hpp>
+#include <memory>
+#include <cassert>
+#include <cmath>
+using namespace nnpp;
+/*
+ * Activation Approximation
+ * Checks the error bounds of the HighAccuracy and Fast activations and derivatives against long double references,
+ * then trains OR with the Fast variants.
+ */
+static const long double referenceActivation(const NeuralNetwork::ActivationType &activationType, const long double &x)
+{
+	switch (activationType)
+	{
+	case NeuralNetwork::Sigmoid:
+		return 1.0L / (1.0L + std::exp(-x));
+	case NeuralNetwork::Tanh:
+		return std::tanh(x);
+	case NeuralNetwork::Swish:
+		return x / (1.0L + std::exp(-x));
+	default:
+		return x;
+	}
+};
+/*
+ */
+static const long double referenceDerivative(const NeuralNetwork::ActivationType &activationType, const long double &x)
+{
+	switch (activationType)
+	{
+	case NeuralNetwork::Sigmoid:
+		return x * (1.0L - x);
+	case NeuralNetwork::Tanh:
+		return 1.0L - std::tanh(x) * std::tanh(x);
+	case NeuralNetwork::Swish:
+	{
+		long double sigmoidX = 1.0L / (1.0L + std::exp(-x));
+		return sigmoidX + x * sigmoidX * (1.0L - sigmoidX);
+	}
+	default:
+		return 1.0L;
+	}
+};
+/*
+ * Returns the largest error relative to max(|reference|, floor) over [-range, range]
+ */
+static const long double maximumError(const NeuralNetwork::ActivationType &activationType, const NeuralNetwork::ActivationAccuracy &accuracy, const bool &derivatives, const long double &floor)
+{
+	static const unsigned long samplesSize = 200001;
+	static const double range = 30;
+	std::vector<double> values(samplesSize);
+	for (unsigned long sampleIndex = 0; sampleIndex < samplesSize; sampleIndex++)
+	{
+		values[sampleIndex] = -range + 2 * range * sampleIndex / (samplesSize - 1);
+	}
+	auto inputs = values;
+	if (derivatives)
+	{
+		Activations::differentiate(activationType, accuracy, values.data(), samplesSize);
+	}
+	else
+	{
+		Activations::activate(activationType, accuracy, values.data(), samplesSize);
+	}
+	long double maximum = 0;
+	for (unsigned long sampleIndex = 0; sampleIndex < samplesSize; sampleIndex++)
+	{
+		long double x = inputs[sampleIndex];
+		long double reference = derivatives ? referenceDerivative(activationType, x) : referenceActivation(activationType, x);
+		long double error = std::abs(values[sampleIndex] - reference) / (std::max)(std::abs(reference), floor);
+		maximum = (std::max)(maximum, error);
+	}
+	return maximum;
+};
+/*
+ */
+int main()
+{
+	for (auto activationType : {NeuralNetwork::Sigmoid, NeuralNetwork::Tanh, NeuralNetwork::Swish, NeuralNetwork::Linear})
+	{
+		auto highError = maximumError(activationType, NeuralNetwork::HighAccuracy, false, 1e-300L);
+		auto fastError = maximumError(activationType, NeuralNetwork::Fast, false, 1e-30L);
+		// Derivatives are compared against max(|reference|, 1) since 1 - tanh^2 cancels near the asymptotes
+		auto highDerivativeError = maximumError(activationType, NeuralNetwork::HighAccuracy, true, 1.0L);
+		auto fastDerivativeError = maximumError(activationType, NeuralNetwork::Fast, true, 1.0L);
+		logger(Logger::Info, "Activation " + std::to_string(activationType) +
+			": high " + std::to_string((double)(highError / 0x1p-53L)) + " ulp, fast " + std::to_string((double)fastError) +
+			", high derivative " + std::to_string((double)(highDerivativeError / 0x1p-53L)) + " ulp, fast derivative " + std::to_string((double)fastDerivativeError));
+		assert(highError <= 8 * 0x1p-53L);
+		assert(highDerivativeError <= 8 * 0x1p-53L);
+		assert(fastError <= 1e-4L);
+		assert(fastDerivativeError <= 1e-4L);
+	}
+	std::vector<std::vector<long double>> trainingInputs = {{{{0, 0}}, {{0, 1}}, {{1, 0}}, {{1, 1}}}};
+	std::vector<std::vector<long double>> trainingOutputs = {{{{0}}, {{1}}, {{1}}, {{1}}}};
+	std::shared_ptr<NeuralNetwork> neuralNetworkPointer(new NeuralNetwork(std::vector<unsigned long>({2, 2, 1})));
+	auto &network = *neuralNetworkPointer;
+	network.activationAccuracy = NeuralNetwork::Fast;
+	auto trainingInputsSize = trainingInputs.size();
+	network.learningRate = 20;
+	for (unsigned long trainingIteration = 0; trainingIteration < 4096; trainingIteration++)
+	{
+		for (unsigned long trainingIndex = 0; trainingIndex < trainingInputsSize; trainingIndex++)
+		{
+			network.feedforward(trainingInputs[trainingIndex]);
+			network.backpropagate(trainingOutputs[trainingIndex]);
+		}
+	}
+	for (unsigned long trainingIndex = 0; trainingIndex < trainingInputsSize; trainingIndex++)
+	{
+		auto outputs = network.predict(trainingInputs[trainingIndex]);
+		assert(std::abs(outputs[0] - trainingOutputs[trainingIndex][0]) <= 0.05);
+	}
+	return 0;
+};
+/*
+ */
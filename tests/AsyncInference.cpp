@@ -0,0 +1,81 @@
+/*
+ */
+#include <NeuralNetwork.hpp>
+#include <Logger.hpp>
+#include <memory>
+#include <cassert>
+using namespace nnpp;
+/*
+ * Asynchronous Inference
+ * Train XOR, then check that inferAsync futures and co_await network.infer(...) agree with the blocking predict.
+ */
+struct InferenceTask
+{
+	struct promise_type
+	{
+		InferenceTask get_return_object()
+		{
+			return {};
+		};
+		std::suspend_never initial_suspend() noexcept
+		{
+			return {};
+		};
+		std::suspend_never final_suspend() noexcept
+		{
+			return {};
+		};
+		void return_void() {};
+		void unhandled_exception()
+		{
+			std::terminate();
+		};
+	};
+};
+/*
+ */
+InferenceTask inferCoroutine(NeuralNetwork &network, std::vector<long double> input, std::promise<std::vector<long double>> &result)
+{
+	auto outputs = co_await network.infer(input);
+	result.set_value(outputs);
+};
+/*
+ */
+int main()
+{
+	std::vector<std::vector<long double>> trainingInputs = {{{{0, 0}}, {{0, 1}}, {{1, 0}}, {{1, 1}}}};
+	std::vector<std::vector<long double>> trainingOutputs = {{{{0}}, {{1}}, {{1}}, {{0}}}};
+	std::shared_ptr<NeuralNetwork> neuralNetworkPointer(new NeuralNetwork(std::vector<unsigned long>({2, 3, 1})));
+	auto &network = *neuralNetworkPointer;
+	auto trainingInputsSize = trainingInputs.size();
+	network.learningRate = 20;
+	unsigned long trainingIteration = 0;
+	for (; trainingIteration < 4096; trainingIteration++)
+	{
+		for (unsigned long trainingIndex = 0; trainingIndex < trainingInputsSize; trainingIndex++)
+		{
+			network.feedforward(trainingInputs[trainingIndex]);
+			network.backpropagate(trainingOutputs[trainingIndex]);
+		}
+	}
+	logger(Logger::Info, "Trained " + std::to_string(trainingIteration) + " iterations");
+	std::vector<std::future<std::vector<long double>>> futures;
+	for (unsigned long trainingIndex = 0; trainingIndex < trainingInputsSize; trainingIndex++)
+	{
+		futures.push_back(network.inferAsync(trainingInputs[trainingIndex]));
+	}
+	for (unsigned long trainingIndex = 0; trainingIndex < trainingInputsSize; trainingIndex++)
+	{
+		auto expectedOutputs = network.predict(trainingInputs[trainingIndex]);
+		auto asyncOutputs = futures[trainingIndex].get();
+		assert(asyncOutputs == expectedOutputs);
+		std::promise<std::vector<long double>> result;
+		auto resultFuture = result.get_future();
+		inferCoroutine(network, trainingInputs[trainingIndex], result);
+		auto coroutineOutputs = resultFuture.get();
+		assert(coroutineOutputs == expectedOutputs);
+	}
+	return 0;
+};
+/*
+ */
@@ -0,0 +1,71 @@
+/*
+ */
+#include <Autotuner.hpp>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+using namespace nnpp;
+/*
+ * Autotuning
+ * Tunes a network, checks that tuning leaves its parameters and results untouched and that a second tuner on the
+ * same host takes the plans from the cache file without timing again, unless the executor size or the weight
+ * precision differ.
+ */
+int main()
+{
+	static const char *cachePath = "autotuning.tuning";
+	{
+		// Plans of other hosts, malformed lines and lines of older versions must be ignored
+		std::ofstream cache(cachePath);
+		cache << "Other CPU\t32\t200\t1\t0\t1\t128\t0.5\nnot a plan\n" << Autotuner::readCpuModel() << "\t32\t200\t1\t128\t0.5\n";
+	}
+	NeuralNetwork network(std::vector<unsigned long>({32, 200, 10}));
+	NeuralNetwork reference(std::vector<unsigned long>({32, 200, 10}));
+	reference.setParameters(network.getParameters());
+	Autotuner autotuner(cachePath);
+	autotuner.repetitions = 2;
+	auto parameters = network.getParameters();
+	auto plans = autotuner.tune(network);
+	assert(plans.size() == 3 && plans[0].schedule == Layer::Automatic);
+	for (unsigned long layerIndex = 1; layerIndex < 3; layerIndex++)
+	{
+		assert(plans[layerIndex].schedule != Layer::Automatic && plans[layerIndex].backwardBlockSize > 0 && plans[layerIndex].seconds > 0);
+		assert(network.layers[layerIndex].schedule == plans[layerIndex].schedule);
+		assert(network.layers[layerIndex].backwardBlockSize == plans[layerIndex].backwardBlockSize);
+	}
+	assert(network.getParameters() == parameters);
+	// Tuned kernels compute the same values
+	std::vector<long double> input(32, 0.25);
+	std::vector<long double> target(10, 0.5);
+	for (unsigned long step = 0; step < 3; step++)
+	{
+		network.feedforward(input);
+		network.backpropagate(target);
+		reference.feedforward(input);
+		reference.backpropagate(target);
+	}
+	assert(network.getParameters() == reference.getParameters());
+	// A new tuner on this host finds both shapes in the cache and applies them without timing
+	Autotuner cachedAutotuner(cachePath);
+	assert(cachedAutotuner.plans.size() == 3);
+	Autotuner::Plan plan;
+	auto workers = network.getExecutor().size();
+	assert(!cachedAutotuner.find(32, 201, workers, Precision::Extended, plan) && cachedAutotuner.find(32, 200, workers, Precision::Extended, plan));
+	assert(!cachedAutotuner.find(32, 200, workers + 1, Precision::Extended, plan) && !cachedAutotuner.find(32, 200, workers, Precision::Half, plan));
+	assert(plan.schedule == plans[1].schedule && plan.backwardBlockSize == plans[1].backwardBlockSize);
+	cachedAutotuner.repetitions = 0;
+	cachedAutotuner.blockSizes.clear();
+	auto cachedPlans = cachedAutotuner.tune(reference);
+	assert(cachedPlans[2].backwardBlockSize == plans[2].backwardBlockSize);
+	assert(reference.layers[2].backwardBlockSize == plans[2].backwardBlockSize);
+	// Half precision weights are timed anew
+	reference.setWeightPrecision(Precision::Half);
+	cachedAutotuner.repetitions = 1;
+	cachedAutotuner.blockSizes = {64};
+	cachedAutotuner.tune(reference);
+	assert(cachedAutotuner.plans.size() == 5 && cachedAutotuner.find(32, 200, workers, Precision::Half, plan) && plan.backwardBlockSize == 64);
+	std::remove(cachePath);
+	return 0;
+};
+/*
+ */
@@ -0,0 +1,58 @@
+/*
+ */
+#include <NeuralNetwork.hpp>
+#include <sigmoid.hpp>
+#include <tanh.hpp>
+#include <swish.hpp>
+#include <linear.hpp>
+#include <softmax.hpp>
+#include <half.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+using namespace nnpp;
+/*
+ * Code Generation
+ * The headers zeuron-codegen generated at build time from the models of CodeGenerationModels must infer what the
+ * models predict, for every activation, the softmax output and served half precision weights. The models are
+ * drawn anew on every build, so tolerances are relative to the outputs.
+ */
+template <void (*infer)(const long double *, long double *)>
+static void checkHeader(const std::string &name, const long double &tolerance)
+{
+	auto network = NeuralNetwork::load(std::string(CODEGEN_DIRECTORY) + "/" + name + ".nrl");
+	auto inputSize = network->layers.front().neurons.size();
+	auto outputSize = network->layers.back().neurons.size();
+	for (unsigned long sampleIndex = 0; sampleIndex < 32; sampleIndex++)
+	{
+		std::vector<long double> input(inputSize);
+		for (unsigned long inputIndex = 0; inputIndex < inputSize; inputIndex++)
+		{
+			input[inputIndex] = std::sin(sampleIndex * 0.7L + inputIndex) * 2;
+		}
+		auto expected = network->predict(input);
+		std::vector<long double> actual(outputSize);
+		infer(input.data(), actual.data());
+		for (unsigned long outputIndex = 0; outputIndex < outputSize; outputIndex++)
+		{
+			assert(std::abs(actual[outputIndex] - expected[outputIndex]) <= tolerance * (std::max)(1.0L, std::abs(expected[outputIndex])));
+		}
+	}
+};
+/*
+ */
+int main()
+{
+	static_assert(sigmoidModel::inputSize == 3 && sigmoidModel::outputSize == 2 && softmaxModel::outputSize == 4);
+	checkHeader<sigmoidModel::infer>("sigmoid", 1e-15);
+	checkHeader<tanhModel::infer>("tanh", 1e-15);
+	// The network's swish takes the exponential in double precision, the header in long double
+	checkHeader<swishModel::infer>("swish", 1e-13);
+	checkHeader<linearModel::infer>("linear", 1e-15);
+	checkHeader<softmaxModel::infer>("softmax", 1e-15);
+	// The network accumulates the half weights in float
+	checkHeader<halfModel::infer>("half", 1e-5);
+	return 0;
+};
+/*
+ */
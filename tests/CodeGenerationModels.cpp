@@ -0,0 +1,37 @@
+/*
+ */
+#include <NeuralNetwork.hpp>
+#include <Logger.hpp>
+#include <string>
+using namespace nnpp;
+/*
+ * Saves the models tests/CodeGeneration.cpp compares against their generated headers, run at build time before
+ * zeuron-codegen
+ * CodeGenerationModels <directory>
+ */
+int main(int argc, char **argv)
+{
+	if (argc != 2)
+	{
+		logger(Logger::Error, "Usage: CodeGenerationModels <directory>");
+		return 1;
+	}
+	std::string directory = argv[1];
+	std::vector<std::pair<std::string, NeuralNetwork::ActivationType>> activations = {{"sigmoid", NeuralNetwork::Sigmoid}, {"tanh", NeuralNetwork::Tanh},
+		{"swish", NeuralNetwork::Swish}, {"linear", NeuralNetwork::Linear}};
+	for (auto &[name, activationType] : activations)
+	{
+		NeuralNetwork network(std::vector<unsigned long>({3, 5, 4, 2}), activationType);
+		network.save(directory + "/" + name + ".nrl");
+	}
+	NeuralNetwork softmax(std::vector<unsigned long>({3, 6, 4}));
+	softmax.outputMode = NeuralNetwork::SoftmaxCrossEntropy;
+	softmax.save(directory + "/softmax.nrl");
+	// Masters keep the full precision weights, the header must use the half values the network serves
+	NeuralNetwork half(std::vector<unsigned long>({3, 8, 2}), NeuralNetwork::Tanh);
+	half.setWeightPrecision(Precision::Half, true);
+	half.save(directory + "/half.nrl");
+	return 0;
+};
+/*
+ */
@@ -0,0 +1,123 @@
+/*
+ */
+#include <NeuralNetwork.hpp>
+#include <Random.hpp>
+#include <Logger.hpp>
+#include <ByteStream.hpp>
+#include <cassert>
+#include <cmath>
+using namespace nnpp;
+/*
+ * Convolutional Classification
+ * Checks the convolution and pooling gradients against finite differences, round-trips a mixed network through
+ * serialization and trains it to tell horizontal from vertical lines.
+ */
+static const long double loss(NeuralNetwork &network, const std::vector<long double> &input, const std::vector<long double> &target)
+{
+	auto outputs = network.predict(input);
+	long double sum = 0;
+	for (unsigned long outputIndex = 0; outputIndex < outputs.size(); outputIndex++)
+	{
+		sum += (target[outputIndex] - outputs[outputIndex]) * (target[outputIndex] - outputs[outputIndex]) / 2;
+	}
+	return sum;
+};
+/*
+ * With a learning rate of 1 one backpropagate step moves every parameter by minus its loss gradient
+ */
+static void checkGradients(NeuralNetwork &network, const std::vector<long double> &input, const std::vector<long double> &target)
+{
+	network.learningRate = 1;
+	auto parameters = network.getParameters();
+	network.feedforward(input);
+	network.backpropagate(target);
+	auto updatedParameters = network.getParameters();
+	network.setParameters(parameters);
+	static const long double step = 1e-6;
+	for (unsigned long parameterIndex = 0; parameterIndex < parameters.size(); parameterIndex++)
+	{
+		auto shifted = parameters;
+		shifted[parameterIndex] += step;
+		network.setParameters(shifted);
+		auto lossAbove = loss(network, input, target);
+		shifted[parameterIndex] -= 2 * step;
+		network.setParameters(shifted);
+		auto lossBelow = loss(network, input, target);
+		long double numericGradient = (lossAbove - lossBelow) / (2 * step);
+		long double analyticGradient = parameters[parameterIndex] - updatedParameters[parameterIndex];
+		assert(std::abs(numericGradient - analyticGradient) <= 1e-6 + 1e-4 * std::abs(numericGradient));
+	}
+	network.setParameters(parameters);
+};
+/*
+ */
+int main()
+{
+	std::vector<long double> image;
+	for (unsigned long pixelIndex = 0; pixelIndex < 2 * 6 * 6; pixelIndex++)
+	{
+		image.push_back(Random::value<long double>(-1, 1));
+	}
+	NeuralNetwork network2D(std::vector<Layer>({
+		Layer(2 * 6 * 6, 2 * 6 * 6),
+		Layer::convolution2D(2, 6, 6, 3, 3, 3, 1, 1),
+		Layer::pooling2D(Layer::MaxPooling, 3, 6, 6, 2),
+		Layer::convolution2D(3, 3, 3, 2, 2, 2, 1, 0),
+		Layer(3, 2 * 2 * 2)
+	}));
+	checkGradients(network2D, image, {0.1, 0.9, 0.5});
+	std::vector<long double> signal(image.begin(), image.begin() + 3 * 16);
+	NeuralNetwork network1D(std::vector<Layer>({
+		Layer(3 * 16, 3 * 16),
+		Layer::convolution1D(3, 16, 4, 5, 2, 2),
+		Layer::pooling1D(Layer::AveragePooling, 4, 8, 2),
+		Layer(2, 4 * 4)
+	}));
+	checkGradients(network1D, signal, {0.3, 0.7});
+	// Serialization keeps the layer geometry and kernels
+	auto byteStream = network2D.serialize();
+	NeuralNetwork restored(byteStream);
+	assert(restored.layers[1].type == Layer::Convolution && restored.layers[2].type == Layer::MaxPooling);
+	assert(restored.predict(image) == network2D.predict(image));
+	// Horizontal against vertical lines on a 5x5 image
+	NeuralNetwork classifier(std::vector<Layer>({
+		Layer(25, 25),
+		Layer::convolution2D(1, 5, 5, 8, 3, 3, 1, 1),
+		Layer::pooling2D(Layer::MaxPooling, 8, 5, 5, 5),
+		Layer(1, 8)
+	}));
+	classifier.learningRate = 0.5;
+	std::vector<std::vector<long double>> inputs;
+	std::vector<std::vector<long double>> outputs;
+	for (unsigned long line = 0; line < 5; line++)
+	{
+		std::vector<long double> horizontal(25, 0);
+		std::vector<long double> vertical(25, 0);
+		for (unsigned long position = 0; position < 5; position++)
+		{
+			horizontal[line * 5 + position] = 1;
+			vertical[position * 5 + line] = 1;
+		}
+		inputs.push_back(horizontal);
+		outputs.push_back({1});
+		inputs.push_back(vertical);
+		outputs.push_back({0});
+	}
+	for (unsigned long epoch = 0; epoch < 3000; epoch++)
+	{
+		for (unsigned long sampleIndex = 0; sampleIndex < inputs.size(); sampleIndex++)
+		{
+			classifier.feedforward(inputs[sampleIndex]);
+			classifier.backpropagate(outputs[sampleIndex]);
+		}
+	}
+	for (unsigned long sampleIndex = 0; sampleIndex < inputs.size(); sampleIndex++)
+	{
+		auto prediction = classifier.predict(inputs[sampleIndex]);
+		logger(Logger::Info, "Sample " + std::to_string(sampleIndex) + ": " + std::to_string((double)prediction[0]));
+		assert(std::abs(prediction[0] - outputs[sampleIndex][0]) < 0.2);
+	}
+	return 0;
+};
+/*
+ */
@@ -0,0 +1,91 @@
+/*
+ */
+#include <DistillationTrainer.hpp>
+#include <Random.hpp>
+#include <Logger.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+using namespace nnpp;
+/*
+ * Distillation
+ * Trains a softmax teacher to split the unit square into three regions, distills it into a student with over ten
+ * times fewer parameters on synthetic samples and checks that the student agrees with the teacher.
+ */
+int main()
+{
+	Dataset dataset;
+	for (unsigned long sampleIndex = 0; sampleIndex < 200; sampleIndex++)
+	{
+		long double x = Random::value<long double>(0, 1);
+		long double y = Random::value<long double>(0, 1);
+		dataset.inputs.push_back({x, y});
+		if (x + y < 0.7)
+		{
+			dataset.outputs.push_back({1, 0, 0});
+		}
+		else if (x > y)
+		{
+			dataset.outputs.push_back({0, 1, 0});
+		}
+		else
+		{
+			dataset.outputs.push_back({0, 0, 1});
+		}
+	}
+	NeuralNetwork teacher(std::vector<unsigned long>({2, 16, 16, 3}));
+	teacher.outputMode = NeuralNetwork::SoftmaxCrossEntropy;
+	teacher.learningRate = 0.5;
+	for (unsigned long epoch = 0; epoch < 300; epoch++)
+	{
+		for (unsigned long sampleIndex = 0; sampleIndex < dataset.size(); sampleIndex++)
+		{
+			teacher.feedforward(dataset.inputs[sampleIndex]);
+			teacher.backpropagate(dataset.outputs[sampleIndex]);
+		}
+	}
+	DistillationTrainer trainer(teacher);
+	trainer.temperature = 2;
+	trainer.learningRate = 0.5;
+	trainer.epochs = 300;
+	auto transferInputs = dataset.inputs;
+	auto synthetic = DistillationTrainer::syntheticInputs(dataset, 200);
+	transferInputs.insert(transferInputs.end(), synthetic.begin(), synthetic.end());
+	auto transferSet = trainer.softTargets(transferInputs);
+	// A higher temperature flattens the teacher's distribution without changing its ranking
+	for (unsigned long sampleIndex = 0; sampleIndex < transferSet.size(); sampleIndex++)
+	{
+		auto &outputs = transferSet.outputs[sampleIndex];
+		auto raw = teacher.predict(transferSet.inputs[sampleIndex]);
+		long double sum = outputs[0] + outputs[1] + outputs[2];
+		assert(std::abs(sum - 1) < 1e-12);
+		assert(std::max_element(outputs.begin(), outputs.end()) - outputs.begin() == std::max_element(raw.begin(), raw.end()) - raw.begin());
+		assert(*std::max_element(outputs.begin(), outputs.end()) <= *std::max_element(raw.begin(), raw.end()) + 1e-12);
+	}
+	auto student = trainer.distill({2, 4, 3}, transferSet);
+	auto report = trainer.evaluate(*student, DistillationTrainer::syntheticInputs(dataset, 1000));
+	logger(Logger::Info, "Student agreement " + std::to_string((double)report.agreement) + " with " +
+		std::to_string(report.studentParameters) + " of " + std::to_string(report.teacherParameters) + " parameters");
+	assert(report.teacherParameters >= 10 * report.studentParameters);
+	assert(student->outputMode == NeuralNetwork::SoftmaxCrossEntropy);
+	assert(report.agreement >= 0.9);
+	// Served at temperature 1 the student is about as confident as the teacher, not as flat as its targets
+	long double teacherConfidence = 0;
+	long double targetsConfidence = 0;
+	long double studentConfidence = 0;
+	for (unsigned long sampleIndex = 0; sampleIndex < transferSet.size(); sampleIndex++)
+	{
+		auto outputs = student->predict(transferSet.inputs[sampleIndex]);
+		auto raw = teacher.predict(transferSet.inputs[sampleIndex]);
+		auto &targets = transferSet.outputs[sampleIndex];
+		studentConfidence += *std::max_element(outputs.begin(), outputs.end());
+		teacherConfidence += *std::max_element(raw.begin(), raw.end());
+		targetsConfidence += *std::max_element(targets.begin(), targets.end());
+	}
+	logger(Logger::Info, "Mean largest probability: teacher " + std::to_string((double)(teacherConfidence / transferSet.size())) + ", targets " +
+		std::to_string((double)(targetsConfidence / transferSet.size())) + ", student " + std::to_string((double)(studentConfidence / transferSet.size())));
+	assert(studentConfidence > targetsConfidence);
+	return 0;
+};
+/*
+ */
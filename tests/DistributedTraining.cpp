@@ -0,0 +1,189 @@
+/*
+ */
+#include <DistributedTrainer.hpp>
+#include <SharedMemoryTransport.hpp>
+#include <TcpTransport.hpp>
+#include <Logger.hpp>
+#include <memory>
+#include <cassert>
+#include <cmath>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+using namespace nnpp;
+/*
+ * Distributed Training
+ * Launches three local worker processes per configuration, over shared memory and over TCP, with both
+ * synchronisation modes. Every replica must adopt rank 0's model, reduce the loss and end up with identical
+ * parameters. All-reduce batches must take one step on the mean gradient of the global batch. Every shared
+ * memory job starts over a segment left behind by a killed job with the same name.
+ */
+static const unsigned long worldSize = 3;
+static const int runWorker(const bool &useTcp, const DistributedTrainer::Mode &mode, const unsigned long &rank, const unsigned short &port)
+{
+	std::unique_ptr<ParameterTransport> transport;
+	if (useTcp)
+	{
+		transport = std::make_unique<TcpTransport>("127.0.0.1", port, rank, worldSize);
+	}
+	else
+	{
+		if (rank == 0)
+		{
+			// Let the other ranks find the stale segment first
+			usleep(100000);
+		}
+		transport = std::make_unique<SharedMemoryTransport>("/zeuron-test-" + std::to_string(port), rank, worldSize, port);
+	}
+	// Only rank 0's settings survive the initial broadcast
+	NeuralNetwork classifier({2, 3, 2});
+	if (rank == 0)
+	{
+		classifier.outputMode = NeuralNetwork::SoftmaxCrossEntropy;
+	}
+	DistributedTrainer classifierTrainer(classifier, *transport, mode);
+	if (classifier.outputMode != NeuralNetwork::SoftmaxCrossEntropy)
+	{
+		return 4;
+	}
+	if (mode == DistributedTrainer::GradientAllReduce)
+	{
+		// A global batch of two samples per rank takes a single step on the mean gradient at its starting point
+		NeuralNetwork batched({2, 3, 1});
+		batched.learningRate = 1;
+		DistributedTrainer batchedTrainer(batched, *transport, mode);
+		NeuralNetwork reference({2, 3, 1});
+		reference.copyModel(batched);
+		auto initial = reference.getParameters();
+		Dataset batch;
+		batch.inputs = {{0, 0}, {0, 1}, {1, 0}, {1, 1}, {0.5, 0}, {0, 0.5}};
+		batch.outputs = {{0}, {1}, {1}, {0}, {1}, {0}};
+		batchedTrainer.train(batch, 2);
+		auto expected = initial;
+		for (unsigned long sampleIndex = 0; sampleIndex < batch.size(); sampleIndex++)
+		{
+			reference.setParameters(initial);
+			reference.feedforward(batch.inputs[sampleIndex]);
+			reference.backpropagate(batch.outputs[sampleIndex]);
+			auto parameters = reference.getParameters();
+			for (unsigned long parameterIndex = 0; parameterIndex < parameters.size(); parameterIndex++)
+			{
+				expected[parameterIndex] += (parameters[parameterIndex] - initial[parameterIndex]) / batch.size();
+			}
+		}
+		auto parameters = batched.getParameters();
+		for (unsigned long parameterIndex = 0; parameterIndex < parameters.size(); parameterIndex++)
+		{
+			if (std::fabs(parameters[parameterIndex] - expected[parameterIndex]) > 1e-12)
+			{
+				return 5;
+			}
+		}
+	}
+	Dataset dataset;
+	for (unsigned long repeat = 0; repeat < 6; repeat++)
+	{
+		dataset.inputs.insert(dataset.inputs.end(), {{0, 0}, {0, 1}, {1, 0}, {1, 1}});
+		dataset.outputs.insert(dataset.outputs.end(), {{0}, {1}, {1}, {1}});
+	}
+	NeuralNetwork network({2, 2, 1});
+	network.learningRate = 2;
+	DistributedTrainer trainer(network, *transport, mode, 2);
+	long double firstLoss = trainer.train(dataset, 1);
+	long double lastLoss = firstLoss;
+	for (unsigned long epoch = 0; epoch < 300; epoch++)
+	{
+		lastLoss = trainer.train(dataset, 1);
+	}
+	if (!(lastLoss < firstLoss))
+	{
+		return 1;
+	}
+	auto parameters = network.getParameters();
+	auto sums = parameters;
+	transport->allReduce(sums);
+	for (unsigned long parameterIndex = 0; parameterIndex < parameters.size(); parameterIndex++)
+	{
+		if (sums[parameterIndex] != parameters[parameterIndex] * worldSize)
+		{
+			return 2;
+		}
+	}
+	if (rank == 0)
+	{
+		logger(Logger::Info, std::string(useTcp ? "TCP" : "Shared memory") + (mode == DistributedTrainer::GradientAllReduce ? " all-reduce" : " averaging") +
+			": loss " + std::to_string((double)firstLoss) + " -> " + std::to_string((double)lastLoss));
+	}
+	return 0;
+};
+/*
+ * Kills a rank 0 waiting for its job's other ranks, leaving its initialised segment behind
+ */
+static void leaveStaleSegment(const unsigned short &port)
+{
+	auto name = "/zeuron-test-" + std::to_string(port);
+	pid_t pid = fork();
+	assert(pid >= 0);
+	if (pid == 0)
+	{
+		SharedMemoryTransport transport(name, 0, worldSize, 0);
+		_exit(0);
+	}
+	int descriptor;
+	while ((descriptor = shm_open(name.c_str(), O_RDWR, 0600)) < 0)
+	{
+		usleep(1000);
+	}
+	close(descriptor);
+	usleep(100000);
+	kill(pid, SIGKILL);
+	waitpid(pid, 0, 0);
+};
+/*
+ */
+int main()
+{
+	unsigned short port = 20000 + getpid() % 20000;
+	for (auto useTcp : {false, true})
+	{
+		for (auto mode : {DistributedTrainer::GradientAllReduce, DistributedTrainer::ModelAveraging})
+		{
+			if (!useTcp)
+			{
+				leaveStaleSegment(port);
+			}
+			std::vector<pid_t> workers;
+			for (unsigned long rank = 0; rank < worldSize; rank++)
+			{
+				pid_t pid = fork();
+				assert(pid >= 0);
+				if (pid == 0)
+				{
+					int status = 3;
+					try
+					{
+						status = runWorker(useTcp, mode, rank, port);
+					}
+					catch (const std::exception &exception)
+					{
+						logger(Logger::Error, exception.what());
+					}
+					_exit(status);
+				}
+				workers.push_back(pid);
+			}
+			for (auto worker : workers)
+			{
+				int status = 0;
+				waitpid(worker, &status, 0);
+				assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+			}
+			port++;
+		}
+	}
+	return 0;
+};
+/*
+ */
@@ -0,0 +1,50 @@
+/*
+ */
+#include <NetworkEnsemble.hpp>
+#include <Random.hpp>
+#include <memory>
+#include <cassert>
+#include <cmath>
+using namespace nnpp;
+/*
+ * Ensemble Inference
+ * An interleaved ensemble of same-topology networks must reproduce each member's outputs and their mean.
+ */
+int main()
+{
+	static const unsigned long modelsSize = 7;
+	std::vector<std::shared_ptr<NeuralNetwork>> networks;
+	for (unsigned long modelIndex = 0; modelIndex < modelsSize; modelIndex++)
+	{
+		networks.push_back(std::make_shared<NeuralNetwork>(std::vector<unsigned long>({5, 12, 9, 3}), NeuralNetwork::Tanh));
+	}
+	NetworkEnsemble ensemble(networks);
+	static const long double tolerance = 1e-12;
+	for (unsigned long sampleIndex = 0; sampleIndex < 32; sampleIndex++)
+	{
+		std::vector<long double> input;
+		for (unsigned long inputIndex = 0; inputIndex < 5; inputIndex++)
+		{
+			input.push_back(Random::value<long double>(-1, 1));
+		}
+		auto modelOutputs = ensemble.predict(input);
+		auto meanOutputs = ensemble.aggregate(input);
+		std::vector<long double> expectedMean(3, 0);
+		for (unsigned long modelIndex = 0; modelIndex < modelsSize; modelIndex++)
+		{
+			auto expectedOutputs = networks[modelIndex]->predict(input);
+			for (unsigned long outputIndex = 0; outputIndex < 3; outputIndex++)
+			{
+				assert(std::abs(modelOutputs[modelIndex][outputIndex] - expectedOutputs[outputIndex]) <= tolerance);
+				expectedMean[outputIndex] += expectedOutputs[outputIndex] / modelsSize;
+			}
+		}
+		for (unsigned long outputIndex = 0; outputIndex < 3; outputIndex++)
+		{
+			assert(std::abs(meanOutputs[outputIndex] - expectedMean[outputIndex]) <= tolerance);
+		}
+	}
+	return 0;
+};
+/*
+ */
@@ -0,0 +1,109 @@
+/*
+ */
+#include <NeuralNetwork.hpp>
+#include <cassert>
+#include <cmath>
+using namespace nnpp;
+/*
+ * Evaluation
+ * Compares evaluate against a serial predict loop on the packed path and the fallback path, for activation and
+ * softmax outputs, and checks that only the requested metrics are computed.
+ */
+static const NeuralNetwork::Evaluation serialEvaluation(NeuralNetwork &network, const Dataset &dataset)
+{
+	NeuralNetwork::Evaluation evaluation;
+	unsigned long outputsCount = 0;
+	unsigned long accurate = 0;
+	for (unsigned long sampleIndex = 0; sampleIndex < dataset.size(); sampleIndex++)
+	{
+		auto outputs = network.predict(dataset.inputs[sampleIndex]);
+		auto &targets = dataset.outputs[sampleIndex];
+		for (unsigned long outputIndex = 0; outputIndex < outputs.size(); outputIndex++)
+		{
+			auto error = std::abs(outputs[outputIndex] - targets[outputIndex]);
+			evaluation.meanSquaredError += error * error;
+			evaluation.meanAbsoluteError += error;
+			evaluation.maxError = std::max(evaluation.maxError, error);
+			auto probability = outputs[outputIndex];
+			evaluation.crossEntropy -= network.outputMode == NeuralNetwork::SoftmaxCrossEntropy ? targets[outputIndex] * std::log(probability) :
+				targets[outputIndex] * std::log(probability) + (1 - targets[outputIndex]) * std::log(1 - probability);
+		}
+		outputsCount += outputs.size();
+		if (outputs.size() == 1)
+		{
+			accurate += (outputs[0] >= 0.5) == (targets[0] >= 0.5);
+		}
+		else
+		{
+			accurate += std::max_element(outputs.begin(), outputs.end()) - outputs.begin() == std::max_element(targets.begin(), targets.end()) - targets.begin();
+		}
+	}
+	evaluation.meanSquaredError /= outputsCount;
+	evaluation.meanAbsoluteError /= outputsCount;
+	evaluation.crossEntropy /= network.outputMode == NeuralNetwork::SoftmaxCrossEntropy ? dataset.size() : outputsCount;
+	evaluation.accuracy = (long double)accurate / dataset.size();
+	evaluation.samples = dataset.size();
+	return evaluation;
+};
+/*
+ */
+static const bool close(const long double &actual, const long double &expected)
+{
+	return std::abs(actual - expected) <= 1e-12 * (1 + std::abs(expected));
+};
+/*
+ */
+static void checkEvaluation(NeuralNetwork &network, const Dataset &dataset)
+{
+	auto expected = serialEvaluation(network, dataset);
+	auto actual = network.evaluate(dataset);
+	assert(actual.samples == expected.samples);
+	assert(close(actual.meanSquaredError, expected.meanSquaredError));
+	assert(close(actual.meanAbsoluteError, expected.meanAbsoluteError));
+	assert(close(actual.crossEntropy, expected.crossEntropy));
+	assert(actual.accuracy == expected.accuracy && actual.maxError == expected.maxError);
+};
+/*
+ */
+int main()
+{
+	Executor executor(3);
+	Dataset dataset;
+	Dataset classes;
+	for (unsigned long sampleIndex = 0; sampleIndex < 1000; sampleIndex++)
+	{
+		long double x = (sampleIndex % 37) / 37.0L;
+		long double y = (sampleIndex % 11) / 11.0L;
+		dataset.inputs.push_back({x, y});
+		dataset.outputs.push_back({x * y > 0.25 ? 1.0L : 0.0L});
+		classes.inputs.push_back({x, y});
+		classes.outputs.push_back({x < 0.3 ? 1.0L : 0, x >= 0.3 && x < 0.6 ? 1.0L : 0, x >= 0.6 ? 1.0L : 0});
+	}
+	NeuralNetwork network(std::vector<unsigned long>({2, 8, 1}));
+	network.executor = &executor;
+	for (unsigned long trainingIteration = 0; trainingIteration < 20; trainingIteration++)
+	{
+		for (unsigned long sampleIndex = 0; sampleIndex < dataset.size(); sampleIndex += 7)
+		{
+			network.feedforward(dataset.inputs[sampleIndex]);
+			network.backpropagate(dataset.outputs[sampleIndex]);
+		}
+	}
+	checkEvaluation(network, dataset);
+	network.activationAccuracy = NeuralNetwork::Fast;
+	checkEvaluation(network, dataset);
+	// Reduced precision weights go through predict
+	network.setWeightPrecision(Precision::Half);
+	checkEvaluation(network, dataset);
+	NeuralNetwork classifier(std::vector<unsigned long>({2, 6, 3}));
+	classifier.executor = &executor;
+	classifier.outputMode = NeuralNetwork::SoftmaxCrossEntropy;
+	checkEvaluation(classifier, classes);
+	// Only the requested metrics are filled in
+	auto partial = classifier.evaluate(classes, NeuralNetwork::Accuracy | NeuralNetwork::MaxError);
+	assert(partial.meanSquaredError == 0 && partial.crossEntropy == 0 && partial.maxError > 0);
+	assert(network.evaluate(Dataset()).samples == 0);
+	return 0;
+};
+/*
+ */
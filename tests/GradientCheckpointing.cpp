@@ -0,0 +1,68 @@
+/*
+ */
+#include <PipelineTrainer.hpp>
+#include <Random.hpp>
+#include <Logger.hpp>
+#include <cassert>
+using namespace nnpp;
+/*
+ * Gradient Checkpointing
+ * Trains the same deep network with every activation kept and with checkpoints, which must give identical
+ * parameters while holding fewer activations, and checks that a memory budget picks a fitting interval.
+ */
+int main()
+{
+	std::vector<unsigned long> layerSizes = {4, 24, 24, 24, 24, 24, 24, 24, 24, 2};
+	Dataset dataset;
+	for (unsigned long sampleIndex = 0; sampleIndex < 64; sampleIndex++)
+	{
+		std::vector<long double> input;
+		for (unsigned long inputIndex = 0; inputIndex < 4; inputIndex++)
+		{
+			input.push_back(Random::value<long double>(-1, 1));
+		}
+		dataset.inputs.push_back(input);
+		dataset.outputs.push_back({input[0] * input[1] > 0 ? 1.0L : 0.0L, input[2] > input[3] ? 1.0L : 0.0L});
+	}
+	for (unsigned long stagesCount : {1ul, 2ul})
+	{
+		NeuralNetwork network(layerSizes);
+		NeuralNetwork checkpointed(layerSizes);
+		checkpointed.setParameters(network.getParameters());
+		PipelineTrainer trainer(network, stagesCount, 4);
+		PipelineTrainer checkpointedTrainer(checkpointed, stagesCount, 4);
+		checkpointedTrainer.checkpointInterval = 3;
+		long double loss = 0, checkpointedLoss = 0;
+		for (unsigned long epoch = 0; epoch < 5; epoch++)
+		{
+			loss = trainer.train(dataset, 32);
+			checkpointedLoss = checkpointedTrainer.train(dataset, 32);
+		}
+		assert(loss == checkpointedLoss);
+		assert(network.getParameters() == checkpointed.getParameters());
+		unsigned long peakBytes = 0, checkpointedPeakBytes = 0;
+		for (auto &stageStatistics : trainer.statistics())
+		{
+			peakBytes += stageStatistics.peakActivationBytes;
+		}
+		for (auto &stageStatistics : checkpointedTrainer.statistics())
+		{
+			checkpointedPeakBytes += stageStatistics.peakActivationBytes;
+		}
+		logger(Logger::Info, std::to_string(stagesCount) + " stages: peak activations " + std::to_string(peakBytes) + " -> " +
+			std::to_string(checkpointedPeakBytes) + " bytes");
+		assert(checkpointedPeakBytes * 2 < peakBytes);
+		assert(peakBytes <= trainer.activationBytes(1, 32) && checkpointedPeakBytes <= checkpointedTrainer.activationBytes(3, 32));
+	}
+	// Half of the full activation memory needs an interval above 1
+	NeuralNetwork network(layerSizes);
+	PipelineTrainer trainer(network, 1, 4);
+	trainer.memoryBudget = trainer.activationBytes(1, 32) / 2;
+	trainer.train(dataset, 32);
+	assert(trainer.effectiveCheckpointInterval > 1);
+	assert(trainer.activationBytes(trainer.effectiveCheckpointInterval, 32) <= trainer.memoryBudget);
+	assert(trainer.activationBytes(trainer.effectiveCheckpointInterval - 1, 32) > trainer.memoryBudget);
+	return 0;
+};
+/*
+ */
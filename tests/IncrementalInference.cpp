@@ -0,0 +1,89 @@
+/*
+ */
+#include <IncrementalEvaluator.hpp>
+#include <Random.hpp>
+#include <algorithm>
+#include <memory>
+#include <cassert>
+#include <cmath>
+using namespace nnpp;
+/*
+ * Incremental Inference
+ * A stream of inputs where a few values change per step must evaluate to the same outputs as a full feedforward,
+ * including after the weights change through backpropagate. With a positive epsilon the outputs stay within the
+ * bound that skipped changes allow and changes below epsilon do not reach the outputs.
+ */
+int main()
+{
+	std::shared_ptr<NeuralNetwork> neuralNetworkPointer(new NeuralNetwork(std::vector<unsigned long>({256, 64, 32, 4}), NeuralNetwork::Tanh));
+	auto &network = *neuralNetworkPointer;
+	network.learningRate = 0.01;
+	IncrementalEvaluator evaluator(network);
+	std::vector<long double> input(256);
+	for (auto &value : input)
+	{
+		value = Random::value<long double>(-1, 1);
+	}
+	static const long double tolerance = 1e-12;
+	for (unsigned long step = 0; step < 2000; step++)
+	{
+		for (unsigned long change = 0; change < 3; change++)
+		{
+			input[Random::value<unsigned long>(0, input.size() - 1)] = Random::value<long double>(-1, 1);
+		}
+		auto &outputs = evaluator.evaluate(input);
+		auto expectedOutputs = network.predict(input);
+		for (unsigned long outputIndex = 0; outputIndex < expectedOutputs.size(); outputIndex++)
+		{
+			assert(std::abs(outputs[outputIndex] - expectedOutputs[outputIndex]) <= tolerance);
+		}
+		if (step % 500 == 499)
+		{
+			network.backpropagate(std::vector<long double>({0.5, -0.5, 0.25, -0.25}));
+		}
+	}
+	// A neuron's cached activation is within epsilon of the one its cached inputs give, and tanh is 1-Lipschitz,
+	// so a layer's error is at most epsilon plus its largest absolute row sum times the previous layer's error
+	static const long double epsilon = 1e-6;
+	IncrementalEvaluator approximateEvaluator(network, epsilon);
+	long double bound = 0;
+	for (unsigned long layerIndex = 1; layerIndex < network.layers.size(); layerIndex++)
+	{
+		long double rowSum = 0;
+		for (auto &neuron : network.layers[layerIndex].neurons)
+		{
+			long double sum = 0;
+			for (auto &weight : neuron.weights)
+			{
+				sum += std::abs(weight);
+			}
+			rowSum = std::max(rowSum, sum);
+		}
+		bound = epsilon + rowSum * bound;
+	}
+	long double largestDeviation = 0;
+	for (unsigned long step = 0; step < 500; step++)
+	{
+		for (unsigned long change = 0; change < 3; change++)
+		{
+			auto &value = input[Random::value<unsigned long>(0, input.size() - 1)];
+			value = std::clamp(value + Random::value<long double>(-1e-5, 1e-5), -1.0L, 1.0L);
+		}
+		auto &outputs = approximateEvaluator.evaluate(input);
+		auto expectedOutputs = network.predict(input);
+		for (unsigned long outputIndex = 0; outputIndex < expectedOutputs.size(); outputIndex++)
+		{
+			largestDeviation = std::max(largestDeviation, std::abs(outputs[outputIndex] - expectedOutputs[outputIndex]));
+		}
+	}
+	assert(largestDeviation > 0 && largestDeviation <= bound + tolerance);
+	// A change far below epsilon moves the first hidden layer by less than epsilon, so nothing reaches the outputs
+	auto previousOutputs = approximateEvaluator.evaluate(input);
+	auto previousExpectedOutputs = network.predict(input);
+	input[0] += 1e-12;
+	assert(approximateEvaluator.evaluate(input) == previousOutputs);
+	assert(network.predict(input) != previousExpectedOutputs);
+	return 0;
+};
+/*
+ */
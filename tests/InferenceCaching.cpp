@@ -0,0 +1,41 @@
+/*
+ */
+#include <InferenceCache.hpp>
+#include <memory>
+#include <cassert>
+using namespace nnpp;
+/*
+ * Inference Caching
+ * Repeated inputs are answered from the cache, inputs within the tolerance share an entry, the capacity bound evicts
+ * the least recently used entries, and backpropagate invalidates everything.
+ */
+int main()
+{
+	std::shared_ptr<NeuralNetwork> neuralNetworkPointer(new NeuralNetwork(std::vector<unsigned long>({2, 8, 1})));
+	auto &network = *neuralNetworkPointer;
+	InferenceCache cache(network, 4, 1, 1e-3);
+	std::vector<long double> input({0.25, 0.75});
+	auto expectedOutputs = network.predict(input);
+	assert(cache.predict(input) == expectedOutputs);
+	assert(cache.predict(input) == expectedOutputs);
+	assert(cache.predict({0.2501, 0.7499}) == expectedOutputs);
+	auto statistics = cache.statistics();
+	assert(statistics.hits == 2 && statistics.misses == 1);
+	for (unsigned long inputIndex = 0; inputIndex < 4; inputIndex++)
+	{
+		cache.predict({(long double)inputIndex, 1});
+	}
+	assert(cache.statistics().evictions == 1);
+	cache.predict(input);
+	assert(cache.statistics().misses == 6);
+	network.feedforward(input);
+	network.backpropagate({1});
+	auto updatedOutputs = cache.predict({0, 1});
+	assert(updatedOutputs == network.predict({0, 1}));
+	statistics = cache.statistics();
+	assert(statistics.invalidations == 1 && statistics.misses == 7);
+	assert(statistics.hitRate() > 0.2 && statistics.hitRate() < 0.3);
+	return 0;
+};
+/*
+ */
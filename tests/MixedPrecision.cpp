@@ -0,0 +1,94 @@
+/*
+ */
+#include <NeuralNetwork.hpp>
+#include <Logger.hpp>
+#include <ByteStream.hpp>
+#include <memory>
+#include <cassert>
+#include <cmath>
+using namespace nnpp;
+using namespace bs;
+/*
+ * Mixed Precision
+ * Conversions round to nearest even, and OR still trains with half and bfloat16 weight storage, including
+ * after a serialization round trip. Reduced precision networks keep no long double copy of their weights, so
+ * they take less memory and serialize smaller than Extended ones.
+ */
+void trainAndCheck(const Precision::Type &precision, const bool &keepMasterWeights)
+{
+	std::vector<std::vector<long double>> trainingInputs = {{{{0, 0}}, {{0, 1}}, {{1, 0}}, {{1, 1}}}};
+	std::vector<std::vector<long double>> trainingOutputs = {{{{0}}, {{1}}, {{1}}, {{1}}}};
+	std::shared_ptr<NeuralNetwork> neuralNetworkPointer(new NeuralNetwork(std::vector<unsigned long>({2, 2, 1})));
+	auto &network = *neuralNetworkPointer;
+	network.setWeightPrecision(precision, keepMasterWeights);
+	auto trainingInputsSize = trainingInputs.size();
+	network.learningRate = 20;
+	unsigned long trainingIteration = 0;
+	for (; trainingIteration < 4096; trainingIteration++)
+	{
+		for (unsigned long trainingIndex = 0; trainingIndex < trainingInputsSize; trainingIndex++)
+		{
+			network.feedforward(trainingInputs[trainingIndex]);
+			network.backpropagate(trainingOutputs[trainingIndex]);
+		}
+	}
+	logger(Logger::Info, "Trained " + std::to_string(trainingIteration) + " iterations with precision " + std::to_string(precision));
+	auto byteStream = network.serialize();
+	NeuralNetwork loadedNetwork(byteStream);
+	assert(loadedNetwork.weightPrecision == precision);
+	assert(loadedNetwork.keepMasterWeights == keepMasterWeights);
+	static const long double tolerance = 0.05;
+	for (unsigned long trainingIndex = 0; trainingIndex < trainingInputsSize; trainingIndex++)
+	{
+		auto outputs = network.predict(trainingInputs[trainingIndex]);
+		auto loadedOutputs = loadedNetwork.predict(trainingInputs[trainingIndex]);
+		assert(outputs == loadedOutputs);
+		assert(std::abs(outputs[0] - trainingOutputs[trainingIndex][0]) <= tolerance);
+	}
+};
+/*
+ */
+int main()
+{
+	assert(Precision::toHalf(1.0f) == 0x3c00);
+	assert(Precision::toHalf(-2.0f) == 0xc000);
+	assert(Precision::toHalf(65504.0f) == 0x7bff);
+	assert(Precision::toHalf(1e6f) == 0x7c00);
+	assert(Precision::toHalf(5.9604645e-8f) == 0x0001);
+	assert(Precision::fromHalf(0x0001) == 5.9604645e-8f);
+	assert(Precision::toBFloat16(1.0f) == 0x3f80);
+	assert(Precision::fromBFloat16(0xc040) == -3.0f);
+	for (float value = -4.0f; value <= 4.0f; value += 0.001f)
+	{
+		assert(std::abs(Precision::fromHalf(Precision::toHalf(value)) - value) <= std::abs(value) * 0x1p-11f + 0x1p-25f);
+		assert(std::abs(Precision::fromBFloat16(Precision::toBFloat16(value)) - value) <= std::abs(value) * 0x1p-8f);
+	}
+	std::vector<uint16_t> weights;
+	std::vector<float> values;
+	float expected = 0;
+	for (unsigned long index = 0; index < 37; index++)
+	{
+		weights.push_back(Precision::toHalf(index * 0.25f - 4));
+		values.push_back(index * 0.5f);
+		expected += (index * 0.25f - 4) * (index * 0.5f);
+	}
+	assert(std::abs(Precision::dot(weights.data(), values.data(), weights.size(), Precision::Half) - expected) <= 1e-3f);
+	NeuralNetwork extended(std::vector<unsigned long>({64, 128, 10}));
+	auto extendedBytes = extended.memoryBytes();
+	auto extendedSize = extended.serialize().bytesSize;
+	for (auto keepMasterWeights : {false, true})
+	{
+		NeuralNetwork reduced(std::vector<unsigned long>({64, 128, 10}));
+		reduced.setWeightPrecision(Precision::Half, keepMasterWeights);
+		// Two bytes per weight, plus four for the float master weights
+		auto divisor = keepMasterWeights ? 2 : 4;
+		assert(reduced.memoryBytes() < extendedBytes / divisor && reduced.serialize().bytesSize < extendedSize / divisor);
+	}
+	trainAndCheck(Precision::Half, true);
+	trainAndCheck(Precision::Half, false);
+	trainAndCheck(Precision::BFloat16, true);
+	trainAndCheck(Precision::BFloat16, false);
+	return 0;
+};
+/*
+ */
@@ -0,0 +1,66 @@
+/*
+ */
+#include <NeuralNetwork.hpp>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+using namespace nnpp;
+/*
+ * Model Loading
+ * Saves models mixing convolution, pooling and dense layers and loads every truncation of their files. Each one
+ * must either throw std::runtime_error or, when it only lacks the trailing output mode like a file of an older
+ * version, load a model with the original's output size. Reduced precision models store their weights after the
+ * output mode, so only their complete files load.
+ */
+static void checkTruncations(NeuralNetwork &network, const bool &olderVersionLoads)
+{
+	static const char *path = "model-loading.nrl";
+	network.save(path);
+	std::vector<char> bytes;
+	{
+		std::ifstream file(path, std::ios::binary);
+		bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+	std::vector<long double> input(8, 0.5);
+	auto expected = network.predict(input);
+	auto olderSize = olderVersionLoads ? bytes.size() - sizeof(unsigned int) : bytes.size();
+	unsigned long loaded = 0;
+	for (unsigned long size = 1; size <= bytes.size(); size++)
+	{
+		{
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			file.write(bytes.data(), size);
+		}
+		try
+		{
+			auto truncated = NeuralNetwork::load(path);
+			assert(size == bytes.size() || size == olderSize);
+			assert(truncated->predict(input).size() == expected.size());
+			loaded++;
+		}
+		catch (const std::runtime_error &)
+		{
+			assert(size != bytes.size() && size != olderSize);
+		}
+	}
+	assert(loaded == (olderVersionLoads ? 2 : 1));
+	assert(NeuralNetwork::load(path)->predict(input) == expected);
+	std::remove(path);
+};
+/*
+ */
+int main()
+{
+	NeuralNetwork network(std::vector<Layer>({Layer(8, 8), Layer::convolution1D(1, 8, 2, 3), Layer::pooling1D(Layer::MaxPooling, 2, 6, 2), Layer(3, 6)}));
+	network.outputMode = NeuralNetwork::SoftmaxCrossEntropy;
+	checkTruncations(network, true);
+	network.setWeightPrecision(Precision::Half, false);
+	checkTruncations(network, false);
+	network.setWeightPrecision(Precision::BFloat16, true);
+	checkTruncations(network, false);
+	return 0;
+};
+/*
+ */
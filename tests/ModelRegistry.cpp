@@ -0,0 +1,79 @@
+/*
+ */
+#include <ModelRegistry.hpp>
+#include <cassert>
+#include <cstdio>
+using namespace nnpp;
+/*
+ * Model Registry
+ * Loads models from files on demand under a memory budget that fits two of them, checks least recently used
+ * eviction, that evicted handles stay usable, the hit and miss counts and that a prefetch turns the next acquire
+ * into a hit.
+ */
+int main()
+{
+	std::vector<std::string> paths;
+	std::vector<std::vector<long double>> expectedOutputs;
+	for (unsigned long modelIndex = 0; modelIndex < 3; modelIndex++)
+	{
+		NeuralNetwork network(std::vector<unsigned long>({2, 16, 16, 1}));
+		paths.push_back("ModelRegistry" + std::to_string(modelIndex) + ".nrl");
+		network.save(paths.back());
+		expectedOutputs.push_back(NeuralNetwork::load(paths.back())->predict({0.5, 0.25}));
+	}
+	auto modelBytes = NeuralNetwork::load(paths[0])->memoryBytes();
+	{
+		ModelRegistry registry(modelBytes * 2 + modelBytes / 2);
+		auto first = registry.acquire(paths[0]);
+		assert(registry.acquire(paths[0]) == first);
+		registry.acquire(paths[1]);
+		assert(registry.residentBytes() == modelBytes * 2);
+		// Touching the first model makes the second the least recently used one
+		registry.acquire(paths[0]);
+		registry.acquire(paths[2]);
+		assert(registry.statistics(paths[0]).resident);
+		assert(!registry.statistics(paths[1]).resident && registry.statistics(paths[1]).evictions == 1);
+		assert(registry.statistics(paths[2]).resident);
+		assert(registry.residentBytes() <= registry.memoryBudget);
+		// Evicting the first model drops only the registry's reference
+		registry.acquire(paths[2]);
+		registry.acquire(paths[1]);
+		assert(!registry.statistics(paths[0]).resident);
+		assert(first->predict({0.5, 0.25}) == expectedOutputs[0]);
+		auto statistics = registry.statistics(paths[0]);
+		assert(statistics.hits == 2 && statistics.misses == 1 && statistics.loads == 1);
+		assert(statistics.hitRate() == 2.0 / 3 && statistics.loadSeconds > 0 && statistics.bytes == modelBytes);
+		assert(registry.statistics(paths[1]).misses == 2 && registry.statistics(paths[1]).loads == 2);
+		// A prefetched model is a hit, whether or not its load has finished
+		registry.prefetch(paths[0]);
+		auto prefetched = registry.acquire(paths[0]);
+		assert(prefetched->predict({0.5, 0.25}) == expectedOutputs[0]);
+		statistics = registry.statistics(paths[0]);
+		assert(statistics.hits == 3 && statistics.misses == 1 && statistics.loads == 2);
+		registry.evict(paths[0]);
+		assert(!registry.statistics(paths[0]).resident);
+		for (unsigned long modelIndex = 0; modelIndex < 3; modelIndex++)
+		{
+			assert(registry.acquire(paths[modelIndex])->predict({0.5, 0.25}) == expectedOutputs[modelIndex]);
+		}
+		// Missing files report their error to every caller
+		bool failed = false;
+		try
+		{
+			registry.acquire("ModelRegistryMissing.nrl");
+		}
+		catch (const std::exception &)
+		{
+			failed = true;
+		}
+		assert(failed && !registry.statistics("ModelRegistryMissing.nrl").resident);
+		registry.prefetch(paths[1]);
+	}
+	for (auto &path : paths)
+	{
+		std::remove(path.c_str());
+	}
+	return 0;
+};
+/*
+ */
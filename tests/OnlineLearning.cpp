@@ -0,0 +1,69 @@
+/*
+ */
+#include <OnlineLearner.hpp>
+#include <Logger.hpp>
+#include <atomic>
+#include <thread>
+#include <cassert>
+#include <cmath>
+using namespace nnpp;
+/*
+ * Online Learning
+ * Serving threads predict without locks while a learner thread trains OR from their feedback and publishes new
+ * snapshots. The published model must converge and match the learner's private copy.
+ */
+int main()
+{
+	std::vector<std::vector<long double>> inputs = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+	std::vector<std::vector<long double>> outputs = {{0}, {1}, {1}, {1}};
+	NeuralNetwork network({2, 2, 1});
+	network.learningRate = 2;
+	OnlineLearner learner(network, 32);
+	learner.start();
+	std::atomic<bool> serving = true;
+	std::atomic<unsigned long> predictions = 0;
+	std::vector<std::thread> servers;
+	for (unsigned long serverIndex = 0; serverIndex < 3; serverIndex++)
+	{
+		servers.emplace_back([&, serverIndex]
+		{
+			unsigned long sampleIndex = serverIndex;
+			while (serving)
+			{
+				auto &input = inputs[sampleIndex++ % inputs.size()];
+				auto prediction = learner.predict(input);
+				assert(prediction.size() == 1 && prediction[0] > 0 && prediction[0] < 1);
+				predictions++;
+			}
+		});
+	}
+	unsigned long accepted = 0;
+	for (unsigned long sampleIndex = 0; accepted < 20000; sampleIndex++)
+	{
+		if (learner.feedback(inputs[sampleIndex % inputs.size()], outputs[sampleIndex % outputs.size()]))
+		{
+			accepted++;
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+	learner.stop();
+	serving = false;
+	for (auto &server : servers)
+	{
+		server.join();
+	}
+	logger(Logger::Info, "Predictions served: " + std::to_string(predictions) + ", versions published: " + std::to_string(learner.publishedVersion));
+	assert(learner.publishedVersion > 1);
+	for (unsigned long sampleIndex = 0; sampleIndex < inputs.size(); sampleIndex++)
+	{
+		auto prediction = learner.predict(inputs[sampleIndex]);
+		assert(std::abs(prediction[0] - outputs[sampleIndex][0]) < 0.1);
+		assert(prediction == learner.network->predict(inputs[sampleIndex]));
+	}
+	return 0;
+};
+/*
+ */
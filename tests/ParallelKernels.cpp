@@ -0,0 +1,56 @@
+/*
+ */
+#include <NeuralNetwork.hpp>
+#include <Random.hpp>
+#include <ByteStream.hpp>
+#include <cassert>
+using namespace nnpp;
+/*
+ * Parallel Kernels
+ * Splitting wide layers across a pinned executor must give exactly the same outputs and training updates as
+ * running them on one thread.
+ */
+int main()
+{
+	NeuralNetwork network({64, 300, 200, 10}, NeuralNetwork::Tanh);
+	network.learningRate = 0.01;
+	auto byteStream = network.serialize();
+	NeuralNetwork parallelNetwork(byteStream);
+	Executor executor(4, {0});
+	parallelNetwork.executor = &executor;
+	parallelNetwork.parallelThreshold = 0;
+	parallelNetwork.parallelGrainSize = 2048;
+	parallelNetwork.backwardBlockSize = 64;
+	network.backwardBlockSize = 64;
+	for (unsigned long step = 0; step < 10; step++)
+	{
+		std::vector<long double> input;
+		std::vector<long double> target;
+		for (unsigned long inputIndex = 0; inputIndex < 64; inputIndex++)
+		{
+			input.push_back(Random::value<long double>(-1, 1));
+		}
+		for (unsigned long outputIndex = 0; outputIndex < 10; outputIndex++)
+		{
+			target.push_back(Random::value<long double>(-1, 1));
+		}
+		network.feedforward(input);
+		parallelNetwork.feedforward(input);
+		assert(network.getOutputs() == parallelNetwork.getOutputs());
+		network.backpropagate(target);
+		parallelNetwork.backpropagate(target);
+	}
+	for (unsigned long layerIndex = 1; layerIndex < network.layers.size(); layerIndex++)
+	{
+		auto &neurons = network.layers[layerIndex].neurons;
+		auto &parallelNeurons = parallelNetwork.layers[layerIndex].neurons;
+		for (unsigned long neuronIndex = 0; neuronIndex < neurons.size(); neuronIndex++)
+		{
+			assert(neurons[neuronIndex].weights == parallelNeurons[neuronIndex].weights);
+			assert(neurons[neuronIndex].bias == parallelNeurons[neuronIndex].bias);
+		}
+	}
+	return 0;
+};
+/*
+ */
@@ -0,0 +1,84 @@
+/*
+ */
+#include <PipelineTrainer.hpp>
+#include <Random.hpp>
+#include <Logger.hpp>
+#include <ByteStream.hpp>
+#include <cassert>
+#include <cmath>
+using namespace nnpp;
+/*
+ * Pipeline Training
+ * With one sample per batch the pipeline must follow plain backpropagation, and with larger batches split into
+ * micro-batches it must still reduce the loss. A half precision network keeping master weights must be evaluated
+ * from its packed weights.
+ */
+int main()
+{
+	Dataset dataset;
+	for (unsigned long sampleIndex = 0; sampleIndex < 64; sampleIndex++)
+	{
+		long double x = Random::value<long double>(-1, 1);
+		long double y = Random::value<long double>(-1, 1);
+		dataset.inputs.push_back({x, y});
+		dataset.outputs.push_back({x * y * 0.5 + 0.5, (x + y) * 0.25 + 0.5});
+	}
+	NeuralNetwork network({2, 9, 7, 8, 6, 2});
+	network.learningRate = 0.5;
+	auto byteStream = network.serialize();
+	NeuralNetwork reference(byteStream);
+	PipelineTrainer trainer(network, 3);
+	assert(trainer.stages.size() == 3);
+	assert(trainer.stages.front().layerBegin == 1 && trainer.stages.back().layerEnd == 6);
+	trainer.train(dataset, 1);
+	for (unsigned long sampleIndex = 0; sampleIndex < dataset.size(); sampleIndex++)
+	{
+		reference.feedforward(dataset.inputs[sampleIndex]);
+		reference.backpropagate(dataset.outputs[sampleIndex]);
+	}
+	for (auto &input : dataset.inputs)
+	{
+		auto outputs = network.predict(input);
+		auto expectedOutputs = reference.predict(input);
+		for (unsigned long outputIndex = 0; outputIndex < outputs.size(); outputIndex++)
+		{
+			assert(std::abs(outputs[outputIndex] - expectedOutputs[outputIndex]) < 1e-12);
+		}
+	}
+	PipelineTrainer batchTrainer(network, 4, 4, 2);
+	long double firstLoss = batchTrainer.train(dataset, 16);
+	long double lastLoss = firstLoss;
+	for (unsigned long epoch = 0; epoch < 300; epoch++)
+	{
+		lastLoss = batchTrainer.train(dataset, 16);
+	}
+	logger(Logger::Info, "Loss " + std::to_string((double)firstLoss) + " -> " + std::to_string((double)lastLoss));
+	assert(lastLoss < firstLoss);
+	for (auto &stageStatistics : batchTrainer.statistics())
+	{
+		logger(Logger::Info, "Layers [" + std::to_string(stageStatistics.layerBegin) + ", " + std::to_string(stageStatistics.layerEnd) +
+			"): utilisation " + std::to_string(stageStatistics.utilisation));
+		assert(stageStatistics.utilisation >= 0 && stageStatistics.utilisation <= 1);
+	}
+	NeuralNetwork half({2, 9, 7, 8, 6, 2});
+	half.setWeightPrecision(Precision::Half, true);
+	long double expectedLoss = 0;
+	for (unsigned long sampleIndex = 0; sampleIndex < dataset.size(); sampleIndex++)
+	{
+		auto outputs = half.predict(dataset.inputs[sampleIndex]);
+		for (unsigned long outputIndex = 0; outputIndex < outputs.size(); outputIndex++)
+		{
+			long double difference = dataset.outputs[sampleIndex][outputIndex] - outputs[outputIndex];
+			expectedLoss += difference * difference;
+		}
+	}
+	expectedLoss /= dataset.size() * 2;
+	PipelineTrainer halfTrainer(half, 2, 8);
+	long double halfLoss = halfTrainer.train(dataset, dataset.size());
+	assert(std::abs(halfLoss - expectedLoss) < 1e-9 * expectedLoss);
+	// Stage workers are reused by every train call
+	assert(halfTrainer.train(dataset, dataset.size()) < halfLoss);
+	return 0;
+};
+/*
+ */
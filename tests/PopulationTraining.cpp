@@ -0,0 +1,69 @@
+/*
+ */
+#include <PopulationTrainer.hpp>
+#include <Logger.hpp>
+#include <memory>
+#include <cassert>
+#include <stdexcept>
+using namespace nnpp;
+/*
+ * Population Training
+ * Trains a population of OR networks, half of them with a learning rate of zero. Successive halving must
+ * terminate the untrainable half early and train the rest to completion. A job with a dataset of the wrong
+ * input width must fail the training instead of hanging it.
+ */
+int main()
+{
+	auto dataset = std::make_shared<Dataset>();
+	dataset->inputs = {{{{0, 0}}, {{0, 1}}, {{1, 0}}, {{1, 1}}}};
+	dataset->outputs = {{{{0}}, {{1}}, {{1}}, {{1}}}};
+	static const unsigned long jobsSize = 16;
+	std::vector<PopulationTrainer::Job> jobs;
+	for (unsigned long jobIndex = 0; jobIndex < jobsSize; jobIndex++)
+	{
+		PopulationTrainer::Job job;
+		job.network = std::make_shared<NeuralNetwork>(std::vector<unsigned long>({2, 2, 1}));
+		job.network->learningRate = jobIndex % 2 ? 0 : 20;
+		job.trainingSet = dataset;
+		job.epochs = 2048 + jobIndex * 64;
+		jobs.push_back(job);
+	}
+	PopulationTrainer trainer;
+	trainer.minimumEpochs = 256;
+	trainer.reductionFactor = 2;
+	auto results = trainer.train(jobs);
+	for (unsigned long jobIndex = 0; jobIndex < jobsSize; jobIndex++)
+	{
+		auto &result = results[jobIndex];
+		logger(Logger::Info, "Job " + std::to_string(jobIndex) + ": loss " + std::to_string((double)result.loss) +
+			", epochs " + std::to_string(result.epochsTrained) + (result.terminated ? ", terminated" : ""));
+		if (jobIndex % 2)
+		{
+			assert(result.terminated);
+			assert(result.epochsTrained == 256);
+		}
+		else
+		{
+			assert(result.loss < 0.01);
+		}
+	}
+	// One malformed job among valid ones
+	auto wideDataset = std::make_shared<Dataset>();
+	wideDataset->inputs = {{0, 0, 1}};
+	wideDataset->outputs = {{1}};
+	jobs.resize(4);
+	jobs[2].trainingSet = wideDataset;
+	bool thrown = false;
+	try
+	{
+		trainer.train(jobs);
+	}
+	catch (const std::runtime_error &)
+	{
+		thrown = true;
+	}
+	assert(thrown);
+	return 0;
+};
+/*
+ */
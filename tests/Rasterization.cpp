@@ -0,0 +1,175 @@
+/*
+ */
+#include <Rasterizer.hpp>
+#include <Visualizer.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <tuple>
+#include <vector>
+using namespace nnpp;
+/*
+ * Rasterization
+ * Compares the span based primitives against per-pixel references on a canvas with guard rows around it, so any
+ * write past the edges is caught, flood fills a region far too large for a recursive fill and renders a network
+ * headless.
+ */
+static const int width = 64;
+static const int height = 48;
+static const int guardRows = 4;
+static const uint32_t background = 0x00000000;
+static const uint32_t guard = 0xdeadbeef;
+/*
+ */
+struct Canvas
+{
+	std::vector<uint32_t> storage = std::vector<uint32_t>((height + 2 * guardRows) * width, guard);
+	Rasterizer rasterizer = Rasterizer(storage.data() + guardRows * width, width, height);
+	std::vector<uint32_t> reference = std::vector<uint32_t>(width * height, background);
+	Canvas()
+	{
+		rasterizer.clear(background);
+	};
+	void set(const int &x, const int &y, const uint32_t &color)
+	{
+		if (rasterizer.contains(x, y))
+		{
+			reference[y * width + x] = color;
+		}
+	};
+	const bool matches() const
+	{
+		for (int index = 0; index < guardRows * width; index++)
+		{
+			if (storage[index] != guard || storage[storage.size() - 1 - index] != guard)
+			{
+				return false;
+			}
+		}
+		return std::equal(reference.begin(), reference.end(), rasterizer.pixels);
+	};
+};
+/*
+ * Unclipped Bresenham, the pixels a clipped line must keep
+ */
+static void referenceLine(Canvas &canvas, int x0, int y0, const int &x1, const int &y1, const uint32_t &color)
+{
+	int dx = std::abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+	int dy = std::abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+	int error = (dx > dy ? dx : -dy) / 2;
+	while (true)
+	{
+		canvas.set(x0, y0, color);
+		if (x0 == x1 && y0 == y1)
+		{
+			return;
+		}
+		auto previousError = error;
+		if (previousError > -dx)
+		{
+			error -= dy;
+			x0 += sx;
+		}
+		if (previousError < dy)
+		{
+			error += dx;
+			y0 += sy;
+		}
+	}
+};
+/*
+ */
+int main()
+{
+	{
+		// Circles inside, across the edges and around a corner
+		Canvas canvas;
+		for (auto [x, y, radius] : std::vector<std::tuple<int, int, int>>({{30, 20, 10}, {-3, 10, 7}, {60, 45, 12}, {32, 24, 0}, {10, 50, 4}}))
+		{
+			canvas.rasterizer.circle(x, y, radius, 0x00ff0000 + radius);
+			for (int dy = -radius; dy <= radius; dy++)
+			{
+				for (int dx = -radius; dx <= radius; dx++)
+				{
+					if (dx * dx + dy * dy <= radius * radius)
+					{
+						canvas.set(x + dx, y + dy, 0x00ff0000 + radius);
+					}
+				}
+			}
+		}
+		assert(canvas.matches());
+	}
+	{
+		// Rectangles and lines partly or entirely outside the canvas
+		Canvas canvas;
+		canvas.rasterizer.rect(-5, 40, 20, 30, 0x00123456);
+		for (int y = 40; y < 70; y++)
+		{
+			for (int x = -5; x < 15; x++)
+			{
+				canvas.set(x, y, 0x00123456);
+			}
+		}
+		std::vector<std::tuple<int, int, int, int>> lines = {{0, 0, 63, 47}, {-20, 5, 90, 30}, {10, -10, 50, 100}, {70, 10, 100, 40}, {-10, 20, 80, 20}, {5, 60, 40, -30}, {63, 0, 0, 47}, {12, 30, 12, 30}};
+		uint32_t color = 0x00000100;
+		for (auto [x0, y0, x1, y1] : lines)
+		{
+			canvas.rasterizer.line(x0, y0, x1, y1, color);
+			referenceLine(canvas, x0, y0, x1, y1, color);
+			color += 0x100;
+		}
+		assert(canvas.matches());
+		canvas.rasterizer.text(-2, 2, "Zeuron 0.3", 2, 0x00ffffff);
+		for (int index = 0; index < width * height; index++)
+		{
+			canvas.reference[index] = canvas.rasterizer.pixels[index];
+		}
+		assert(canvas.matches());
+	}
+	{
+		// A ring's inside is filled, its outside and the ring itself are not
+		Canvas canvas;
+		canvas.rasterizer.circle(32, 24, 20, 0x00ffffff);
+		canvas.rasterizer.circle(32, 24, 17, background);
+		canvas.rasterizer.fill(32, 24, 0x000000ff);
+		assert(canvas.rasterizer.pixel(32, 24) == 0x000000ff && canvas.rasterizer.pixel(32 + 16, 24) == 0x000000ff);
+		assert(canvas.rasterizer.pixel(32 + 19, 24) == 0x00ffffff && canvas.rasterizer.pixel(0, 0) == background);
+		canvas.rasterizer.fill(0, 0, 0x0000ff00);
+		for (int index = 0; index < width * height; index++)
+		{
+			assert(canvas.rasterizer.pixels[index] != background);
+		}
+		assert(canvas.rasterizer.pixel(width - 1, height - 1) == 0x0000ff00);
+	}
+	{
+		// Millions of pixels in one region, a recursive fill would overflow the stack
+		static const int side = 2048;
+		std::vector<uint32_t> pixels(side * side, background);
+		Rasterizer rasterizer(pixels.data(), side, side);
+		for (int x = 0; x < side; x += 8)
+		{
+			rasterizer.line(x, x % 16 ? 0 : 1, x, side - (x % 16 ? 2 : 1), 0x00ffffff);
+		}
+		rasterizer.fill(1, 1, 0x000000ff);
+		unsigned long filled = std::count(pixels.begin(), pixels.end(), 0x000000ff);
+		unsigned long walls = std::count(pixels.begin(), pixels.end(), 0x00ffffff);
+		assert(filled + walls == pixels.size());
+	}
+	{
+		NeuralNetwork network(std::vector<unsigned long>({3, 5, 2}));
+		network.feedforward({0.1, 0.5, 0.9});
+		Visualizer visualizer(network, 320, 240, true);
+		visualizer.render();
+		assert(!visualizer.f && !visualizer.windowThread.joinable());
+		assert(visualizer.rasterizer.pixel(0, 0) == 0x0000bb99);
+		// The first output neuron is centred at the right edge less its radius, the top of the layer
+		auto x = 320 / 2 + (320 - 20) / 2;
+		auto y = 240 / 2 - (240 - 20) / 2;
+		assert(visualizer.rasterizer.pixel(x, y) == visualizer.mapWeightToColor(network.layers[2].neurons[0]));
+		visualizer.close();
+	}
+	return 0;
+};
+/*
+ */
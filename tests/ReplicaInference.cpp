@@ -0,0 +1,66 @@
+/*
+ */
+#include <ReplicaSet.hpp>
+#include <Numa.hpp>
+#include <Random.hpp>
+#include <memory>
+#include <cassert>
+#include <thread>
+using namespace nnpp;
+/*
+ * Replica Inference
+ * Per-node read-only replicas must produce exactly the outputs of the network they were built from, from any node,
+ * whatever its activation accuracy. Reduced precision networks are rejected with an exception.
+ */
+int main()
+{
+	std::shared_ptr<NeuralNetwork> neuralNetworkPointer(new NeuralNetwork(std::vector<unsigned long>({8, 32, 16, 4}), NeuralNetwork::Tanh));
+	auto &network = *neuralNetworkPointer;
+	ReplicaSet replicaSet(network);
+	assert(replicaSet.replicas.size() == Numa::nodeCount());
+	for (unsigned long sampleIndex = 0; sampleIndex < 64; sampleIndex++)
+	{
+		std::vector<long double> input;
+		for (unsigned long inputIndex = 0; inputIndex < 8; inputIndex++)
+		{
+			input.push_back(Random::value<long double>(-1, 1));
+		}
+		auto expectedOutputs = network.predict(input);
+		for (unsigned long node = 0; node < replicaSet.replicas.size(); node++)
+		{
+			std::thread reader([&, node]
+			{
+				Numa::pinThreadToNode(node);
+				assert(replicaSet.predict(input) == expectedOutputs);
+				assert(replicaSet.replica(node).predict(input) == expectedOutputs);
+			});
+			reader.join();
+		}
+	}
+	for (auto accuracy : {NeuralNetwork::HighAccuracy, NeuralNetwork::Fast})
+	{
+		for (auto outputMode : {NeuralNetwork::ActivationOutput, NeuralNetwork::SoftmaxCrossEntropy})
+		{
+			network.activationAccuracy = accuracy;
+			network.outputMode = outputMode;
+			PackedNetwork packed(network);
+			std::vector<long double> input = {0.5, -0.25, 0.75, 0.1, -0.9, 0.3, 0, 1};
+			assert(packed.predict(input) == network.predict(input));
+		}
+	}
+	network.setWeightPrecision(Precision::Half);
+	assert(!PackedNetwork::supports(network));
+	bool rejected = false;
+	try
+	{
+		replicaSet.refresh(network);
+	}
+	catch (const std::runtime_error &)
+	{
+		rejected = true;
+	}
+	assert(rejected && replicaSet.replicas.size() == Numa::nodeCount());
+	return 0;
+};
+/*
+ */
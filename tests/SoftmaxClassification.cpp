@@ -0,0 +1,124 @@
+/*
+ */
+#include <NeuralNetwork.hpp>
+#include <PackedNetwork.hpp>
+#include <PipelineTrainer.hpp>
+#include <Logger.hpp>
+#include <ByteStream.hpp>
+#include <cassert>
+#include <cmath>
+using namespace nnpp;
+/*
+ * Softmax Classification
+ * Checks the fused softmax/cross-entropy gradient against finite differences, the stability of the softmax on
+ * large logits, the serialization of the output mode and trains the multi-class XOR of MultiClassClassification.
+ */
+static const long double crossEntropy(NeuralNetwork &network, const std::vector<long double> &input, const std::vector<long double> &target)
+{
+	auto outputs = network.predict(input);
+	long double sum = 0;
+	for (unsigned long outputIndex = 0; outputIndex < outputs.size(); outputIndex++)
+	{
+		sum -= target[outputIndex] * std::log(outputs[outputIndex]);
+	}
+	return sum;
+};
+/*
+ */
+int main()
+{
+	std::vector<std::vector<long double>> trainingInputs = {{{{0, 0}}, {{0, 1}}, {{1, 0}}, {{1, 1}}}};
+	std::vector<std::vector<long double>> trainingOutputs = {{{{1, 0, 0}}, {{0, 1, 0}}, {{0, 0, 1}}, {{1, 0, 0}}}};
+	auto trainingInputsSize = trainingInputs.size();
+	// With a learning rate of 1 one backpropagate step moves every parameter by minus its cross-entropy gradient
+	NeuralNetwork checked(std::vector<unsigned long>({2, 4, 3}));
+	checked.outputMode = NeuralNetwork::SoftmaxCrossEntropy;
+	checked.learningRate = 1;
+	std::vector<long double> input = {0.3, 0.8};
+	std::vector<long double> target = {0, 1, 0};
+	auto parameters = checked.getParameters();
+	checked.feedforward(input);
+	checked.backpropagate(target);
+	auto updatedParameters = checked.getParameters();
+	static const long double step = 1e-6;
+	for (unsigned long parameterIndex = 0; parameterIndex < parameters.size(); parameterIndex++)
+	{
+		auto shifted = parameters;
+		shifted[parameterIndex] += step;
+		checked.setParameters(shifted);
+		auto lossAbove = crossEntropy(checked, input, target);
+		shifted[parameterIndex] -= 2 * step;
+		checked.setParameters(shifted);
+		auto lossBelow = crossEntropy(checked, input, target);
+		long double numericGradient = (lossAbove - lossBelow) / (2 * step);
+		long double analyticGradient = parameters[parameterIndex] - updatedParameters[parameterIndex];
+		assert(std::abs(numericGradient - analyticGradient) <= 1e-6 + 1e-4 * std::abs(numericGradient));
+	}
+	checked.setParameters(parameters);
+	// Logits far beyond the exponent's range still give a distribution
+	for (auto accuracy : {NeuralNetwork::Exact, NeuralNetwork::HighAccuracy, NeuralNetwork::Fast})
+	{
+		NeuralNetwork large(std::vector<unsigned long>({1, 3}), NeuralNetwork::Linear);
+		large.outputMode = NeuralNetwork::SoftmaxCrossEntropy;
+		large.activationAccuracy = accuracy;
+		large.setParameters({20000, 0, 19999, 0, -20000, 0});
+		auto outputs = large.predict({1});
+		assert(std::isfinite(outputs[0]) && std::abs(outputs[0] + outputs[1] + outputs[2] - 1) < 1e-6);
+		assert(std::abs(outputs[0] - 1 / (1 + std::exp(-1.0L))) < 1e-3 && outputs[2] < 1e-30);
+	}
+	NeuralNetwork network(std::vector<unsigned long>({2, 4, 3}));
+	network.outputMode = NeuralNetwork::SoftmaxCrossEntropy;
+	network.learningRate = 1;
+	unsigned long trainingIteration = 0;
+	for (; trainingIteration < 1024; trainingIteration++)
+	{
+		for (unsigned long trainingIndex = 0; trainingIndex < trainingInputsSize; trainingIndex++)
+		{
+			network.feedforward(trainingInputs[trainingIndex]);
+			network.backpropagate(trainingOutputs[trainingIndex]);
+		}
+	}
+	logger(Logger::Info, "Trained " + std::to_string(trainingIteration) + " iterations");
+	static const long double tolerance = 0.05;
+	PackedNetwork packed(network);
+	for (unsigned long trainingIndex = 0; trainingIndex < trainingInputsSize; trainingIndex++)
+	{
+		auto &expectedOutput = trainingOutputs[trainingIndex];
+		auto actualOutputs = network.predict(trainingInputs[trainingIndex]);
+		auto packedOutputs = packed.predict(trainingInputs[trainingIndex]);
+		long double sum = 0;
+		for (unsigned long outputIndex = 0; outputIndex < actualOutputs.size(); ++outputIndex)
+		{
+			assert(std::abs(actualOutputs[outputIndex] - expectedOutput[outputIndex]) <= tolerance);
+			assert(packedOutputs[outputIndex] == actualOutputs[outputIndex]);
+			sum += actualOutputs[outputIndex];
+		}
+		assert(std::abs(sum - 1) < 1e-12);
+	}
+	// The output mode survives serialization
+	auto byteStream = network.serialize();
+	NeuralNetwork restored(byteStream);
+	assert(restored.outputMode == NeuralNetwork::SoftmaxCrossEntropy);
+	assert(restored.predict(trainingInputs[1]) == network.predict(trainingInputs[1]));
+	// The pipeline applies the same gradient as backpropagate
+	NeuralNetwork plain(std::vector<unsigned long>({2, 4, 3}));
+	NeuralNetwork pipelined(std::vector<unsigned long>({2, 4, 3}));
+	plain.outputMode = pipelined.outputMode = NeuralNetwork::SoftmaxCrossEntropy;
+	pipelined.setParameters(plain.getParameters());
+	PipelineTrainer pipelineTrainer(pipelined, 2);
+	pipelineTrainer.train({trainingInputs, trainingOutputs}, 1);
+	for (unsigned long trainingIndex = 0; trainingIndex < trainingInputsSize; trainingIndex++)
+	{
+		plain.feedforward(trainingInputs[trainingIndex]);
+		plain.backpropagate(trainingOutputs[trainingIndex]);
+	}
+	auto plainParameters = plain.getParameters();
+	auto pipelinedParameters = pipelined.getParameters();
+	for (unsigned long parameterIndex = 0; parameterIndex < plainParameters.size(); parameterIndex++)
+	{
+		assert(std::abs(plainParameters[parameterIndex] - pipelinedParameters[parameterIndex]) < 1e-12);
+	}
+	return 0;
+};
+/*
+ */
@@ -0,0 +1,103 @@
+/*
+ */
+#include <NeuralNetwork.hpp>
+#include <Random.hpp>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+using namespace nnpp;
+/*
+ * Streaming Inference
+ * Runs zeuron-infer with several threads and small batches over CSV from a file and binary rows from stdin, for
+ * a model predicted from a packed copy and a half precision one predicted through the network. Every output row
+ * must equal predict, in input order, and malformed CSV lines must fail the run.
+ */
+static const unsigned long rowsCount = 100;
+static const int runTool(const std::string &arguments)
+{
+	return std::system((std::string(INFER_TOOL) + " " + arguments).c_str());
+};
+/*
+ */
+static void checkModel(const std::string &name, NeuralNetwork &network)
+{
+	network.save(name + ".nrl");
+	auto inputSize = network.layers.front().neurons.size();
+	auto outputSize = network.layers.back().neurons.size();
+	// Multiples of 1 / 64 are printed exactly, so both formats carry the same inputs
+	std::vector<std::vector<long double>> inputs(rowsCount, std::vector<long double>(inputSize));
+	{
+		std::ofstream csv(name + ".csv");
+		std::ofstream binary(name + ".bin", std::ios::binary);
+		csv.precision(std::numeric_limits<double>::max_digits10);
+		for (auto &row : inputs)
+		{
+			for (unsigned long valueIndex = 0; valueIndex < inputSize; valueIndex++)
+			{
+				double value = Random::value<long>(-128, 128) / 64.0;
+				row[valueIndex] = value;
+				csv << (valueIndex ? "," : "") << value;
+				binary.write((const char *)&value, sizeof(double));
+			}
+			// Trailing whitespace and carriage returns are accepted
+			csv << (&row == &inputs.front() ? " \r\n" : "\n");
+		}
+	}
+	assert(runTool(name + ".nrl -i " + name + ".csv -o " + name + ".out.csv -t 3 -b 7") == 0);
+	assert(runTool(name + ".nrl -f binary -t 3 -b 5 < " + name + ".bin > " + name + ".out.bin") == 0);
+	std::ifstream csv(name + ".out.csv");
+	std::ifstream binary(name + ".out.bin", std::ios::binary);
+	std::string line;
+	unsigned long rowIndex = 0;
+	for (; std::getline(csv, line); rowIndex++)
+	{
+		assert(rowIndex < rowsCount);
+		auto expected = network.predict(inputs[rowIndex]);
+		std::vector<double> binaryRow(outputSize);
+		assert(binary.read((char *)binaryRow.data(), outputSize * sizeof(double)));
+		std::istringstream values(line);
+		for (unsigned long valueIndex = 0; valueIndex < outputSize; valueIndex++)
+		{
+			std::string value;
+			std::getline(values, value, ',');
+			assert(std::stod(value) == (double)expected[valueIndex]);
+			assert(binaryRow[valueIndex] == (double)expected[valueIndex]);
+		}
+	}
+	assert(rowIndex == rowsCount && binary.peek() == std::ifstream::traits_type::eof());
+	for (auto extension : {".nrl", ".csv", ".bin", ".out.csv", ".out.bin"})
+	{
+		std::remove((name + extension).c_str());
+	}
+};
+/*
+ */
+int main()
+{
+	NeuralNetwork network(std::vector<unsigned long>({3, 8, 2}));
+	checkModel("streaming", network);
+	NeuralNetwork half(std::vector<unsigned long>({3, 8, 2}), NeuralNetwork::Tanh);
+	half.setWeightPrecision(Precision::Half);
+	checkModel("streaming-half", half);
+	// Empty lines, missing or extra values and trailing characters are rejected
+	network.save("streaming.nrl");
+	for (auto text : {"1,2,3\n\n1,2,3\n", "1,2\n", "1,2,3,4\n", "1,2,3x\n", "1,2,3 ,\n"})
+	{
+		{
+			std::ofstream csv("streaming.csv");
+			csv << text;
+		}
+		assert(runTool("streaming.nrl -i streaming.csv -o streaming.out.csv 2>/dev/null") != 0);
+	}
+	for (auto extension : {".nrl", ".csv", ".out.csv"})
+	{
+		std::remove((std::string("streaming") + extension).c_str());
+	}
+	return 0;
+};
+/*
+ */
@@ -0,0 +1,219 @@
+/*
+ */
+#include <Executor.hpp>
+#include <NeuralNetwork.hpp>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <stdexcept>
+using namespace nnpp;
+/*
+ * Task Scheduling
+ * Checks that High priority tasks overtake queued Normal ones, that an executor can run on a pool owned by the host
+ * application, that automatically sized executors share the core budget with core reservations and that throwing
+ * tasks are contained.
+ */
+struct HostThreadPool : Executor::HostPool
+{
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::deque<Executor::Task> runners;
+	bool stopping = false;
+	std::thread thread;
+	unsigned long posted = 0;
+	HostThreadPool()
+	{
+		thread = std::thread([this]
+		{
+			while (true)
+			{
+				Executor::Task runner;
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					condition.wait(lock, [this] { return stopping || !runners.empty(); });
+					if (runners.empty())
+					{
+						return;
+					}
+					runner = std::move(runners.front());
+					runners.pop_front();
+				}
+				runner();
+			}
+		});
+	};
+	~HostThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		condition.notify_all();
+		thread.join();
+	};
+	void post(Executor::Task runner) override
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			runners.push_back(std::move(runner));
+			posted++;
+		}
+		condition.notify_one();
+	};
+	const unsigned long concurrency() const override
+	{
+		return 1;
+	};
+};
+/*
+ */
+int main()
+{
+	Executor::setCoreBudget(3);
+	assert(Executor::coreBudget() == 3);
+	{
+		// Explicit sizes are served first and automatic executors split the rest, never exceeding the budget
+		Executor first;
+		Executor second;
+		{
+			Executor explicitlySized(2);
+			assert(explicitlySized.size() == 2 && first.size() + second.size() == 1);
+			Executor clamped(2);
+			assert(clamped.size() == 1 && first.size() == 0 && second.size() == 0);
+			// Without an active worker the submitting thread runs the task
+			bool ran = false;
+			first.submit([&] { ran = true; });
+			assert(ran);
+		}
+		assert(first.size() + second.size() == 3);
+		{
+			// Threads outside the executors are served before them
+			Executor::CoreReservation reservation(2);
+			assert(first.size() + second.size() == 1);
+		}
+		assert(first.size() + second.size() == 3);
+		// Lowering the budget parks workers of live executors
+		Executor::setCoreBudget(1);
+		assert(first.size() + second.size() == 1);
+		std::atomic<unsigned long> remaining = 8;
+		for (unsigned long taskIndex = 0; taskIndex < 8; taskIndex++)
+		{
+			first.submit([&]
+			{
+				if (--remaining == 0)
+				{
+					first.notifyCompletion();
+				}
+			});
+		}
+		first.wait(remaining);
+		Executor::setCoreBudget(3);
+		assert(first.size() + second.size() == 3);
+	}
+	{
+		Executor executor;
+		assert(executor.size() == 3);
+	}
+	Executor::setCoreBudget(0);
+	{
+		// Block the only worker, queue Normal tasks then a High one: the High one runs first
+		Executor executor(1);
+		std::mutex mutex;
+		std::condition_variable condition;
+		bool released = false;
+		std::vector<int> order;
+		std::atomic<unsigned long> remaining = 6;
+		executor.submit([&]
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [&] { return released; });
+			if (--remaining == 0)
+			{
+				executor.notifyCompletion();
+			}
+		});
+		for (int taskIndex = 0; taskIndex < 4; taskIndex++)
+		{
+			executor.submit([&, taskIndex]
+			{
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					order.push_back(taskIndex);
+				}
+				if (--remaining == 0)
+				{
+					executor.notifyCompletion();
+				}
+			}, Executor::Normal);
+		}
+		executor.submit([&]
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				order.push_back(-1);
+			}
+			if (--remaining == 0)
+			{
+				executor.notifyCompletion();
+			}
+		}, Executor::High);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			released = true;
+		}
+		condition.notify_all();
+		executor.wait(remaining);
+		assert(order.size() == 5 && order[0] == -1);
+	}
+	{
+		// A throwing task leaves the worker running and its exception is kept for the caller
+		Executor executor(1);
+		std::atomic<unsigned long> remaining = 2;
+		executor.submit([&]
+		{
+			remaining--;
+			throw std::runtime_error("task failed");
+		});
+		executor.submit([&]
+		{
+			if (--remaining == 0)
+			{
+				executor.notifyCompletion();
+			}
+		});
+		executor.wait(remaining);
+		// The failing task may still be unwinding on the worker
+		std::exception_ptr exception;
+		while (!(exception = executor.takeTaskException()))
+		{
+			std::this_thread::yield();
+		}
+		assert(!executor.takeTaskException());
+	}
+	{
+		// A host pool runs submitted tasks, parallel loops and inference
+		HostThreadPool hostPool;
+		Executor executor(hostPool);
+		assert(executor.size() == 1);
+		std::vector<unsigned long> values(1000, 0);
+		executor.parallelFor(0, values.size(), 10, [&](unsigned long begin, unsigned long end)
+		{
+			for (unsigned long index = begin; index < end; index++)
+			{
+				values[index] = index;
+			}
+		});
+		for (unsigned long index = 0; index < values.size(); index++)
+		{
+			assert(values[index] == index);
+		}
+		NeuralNetwork network(std::vector<unsigned long>({2, 3, 1}));
+		network.executor = &executor;
+		auto expected = network.predict({0.5, 0.25});
+		assert(network.inferAsync({0.5, 0.25}).get() == expected);
+		assert(hostPool.posted > 0);
+	}
+	return 0;
+};
+/*
+ */
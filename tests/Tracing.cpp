@@ -0,0 +1,109 @@
+/*
+ */
+#include <NeuralNetwork.hpp>
+#include <Tracer.hpp>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+using namespace nnpp;
+/*
+ * Tracing
+ * Records training, inference and a contended lock, writes them as Chrome Trace Event JSON and checks that a full
+ * ring buffer keeps only the newest spans, also while it is read concurrently.
+ */
+int main()
+{
+	NeuralNetwork network(std::vector<unsigned long>({2, 3, 1}));
+	network.feedforward({0, 1});
+	assert(Tracer::events().empty());
+	Tracer::start();
+	network.feedforward({0, 1});
+	network.backpropagate({1});
+	{
+		// Hold the network's mutex while another thread predicts so it has to wait
+		std::unique_lock<std::mutex> lock(network.mutex);
+		std::thread reader([&]
+		{
+			network.predict({1, 0});
+		});
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		lock.unlock();
+		reader.join();
+	}
+	Tracer::stop();
+	network.feedforward({0, 1});
+	unsigned long forwardLayers = 0;
+	bool waited = false;
+	for (auto &event : Tracer::events())
+	{
+		assert(event.end >= event.begin);
+		forwardLayers += std::string(event.name) == "forward layer";
+		if (std::string(event.name) == "mutex wait")
+		{
+			waited = true;
+			assert(event.end - event.begin >= 10000000);
+		}
+	}
+	// Two layers per pass, feedforward and predict while tracing
+	assert(forwardLayers == 4 && waited);
+	Tracer::write("trace.json");
+	std::ifstream file("trace.json");
+	std::stringstream json;
+	json << file.rdbuf();
+	auto trace = json.str();
+	for (auto expected : {"\"traceEvents\":[", "\"name\":\"backpropagate\"", "\"ph\":\"X\"", "\"args\":{\"layer\":2}", "\"thread_name\""})
+	{
+		assert(trace.find(expected) != std::string::npos);
+	}
+	std::remove("trace.json");
+	Tracer::start(4);
+	for (long spanIndex = 0; spanIndex < 10; spanIndex++)
+	{
+		NNPP_TRACE_SCOPE("span", "test", spanIndex);
+	}
+	Tracer::stop();
+	auto events = Tracer::events();
+	assert(events.size() == 4 && events.front().argument == 6 && events.back().argument == 9);
+	// Reading while the ring wraps never returns a torn span: each one's fields come from the same record
+	Tracer::start(8);
+	std::atomic<bool> recording = true;
+	std::thread writer([&]
+	{
+		for (unsigned long spanIndex = 0; recording; spanIndex++)
+		{
+			Tracer::record("span", "test", spanIndex, spanIndex + 1, spanIndex);
+		}
+	});
+	for (unsigned long readIndex = 0; readIndex < 2000; readIndex++)
+	{
+		for (auto &event : Tracer::events())
+		{
+			assert(event.end == event.begin + 1 && event.argument == (long)event.begin);
+		}
+	}
+	recording = false;
+	writer.join();
+	Tracer::stop();
+	// Every lock on a network's mutex reports its wait
+	Tracer::start();
+	{
+		std::unique_lock<std::mutex> lock(network.mutex);
+		std::thread reader([&]
+		{
+			network.getParameters();
+		});
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		lock.unlock();
+		reader.join();
+	}
+	Tracer::stop();
+	events = Tracer::events();
+	assert(std::any_of(events.begin(), events.end(), [](const Tracer::Event &event) { return std::string(event.name) == "mutex wait"; }));
+	return 0;
+};
+/*
+ */
@@ -0,0 +1,28 @@
+/*
+ */
+#include <CodeGenerator.hpp>
+#include <Logger.hpp>
+using namespace nnpp;
+/*
+ * zeuron-codegen <model.nrl> <namespace> <output.hpp>
+ */
+int main(int argc, char **argv)
+{
+	if (argc != 4)
+	{
+		logger(Logger::Error, "Usage: zeuron-codegen <model.nrl> <namespace> <output.hpp>");
+		return 1;
+	}
+	try
+	{
+		CodeGenerator::writeHeader(argv[1], argv[2], argv[3]);
+	}
+	catch (const std::exception &exception)
+	{
+		logger(Logger::Error, exception.what());
+		return 1;
+	}
+	return 0;
+};
+/*
+ */
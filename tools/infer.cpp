@@ -0,0 +1,357 @@
+/*
+ */
+#include <PackedNetwork.hpp>
+#include <BoundedQueue.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+using namespace nnpp;
+/*
+ * zeuron-infer <model.nrl> [-i input] [-o output] [-f csv|binary] [-b rows per batch] [-t threads]
+ *
+ * Streams rows from the input (stdin by default) through the model and writes one output row per input row, in
+ * input order, to the output (stdout by default). CSV rows are comma separated, binary rows are packed native
+ * doubles, input size values per input row and output size values per output row. Batches are predicted in
+ * parallel on an Executor while a writer thread emits them in order; at most queue capacity batches are in
+ * flight, so memory stays bounded on inputs of any length. Empty lines, missing or extra values and trailing
+ * characters other than whitespace are errors. Throughput, batch latency percentiles and errors go to stderr so
+ * stdout only carries the outputs.
+ */
+struct Options
+{
+	std::string model;
+	std::string input = "-";
+	std::string output = "-";
+	bool binary = false;
+	unsigned long batchRows = 256;
+	unsigned long threads = 0;
+};
+/*
+ */
+struct Batch
+{
+	unsigned long rows = 0;
+	std::vector<long double> inputs;
+	std::vector<long double> outputs;
+	std::chrono::steady_clock::time_point submitted;
+	std::promise<void> predicted;
+	std::future<void> done;
+};
+/*
+ */
+static const bool parseOptions(int argc, char **argv, Options &options)
+{
+	if (argc < 2)
+	{
+		return false;
+	}
+	options.model = argv[1];
+	for (int argumentIndex = 2; argumentIndex < argc; argumentIndex += 2)
+	{
+		if (argumentIndex + 1 >= argc)
+		{
+			return false;
+		}
+		std::string flag = argv[argumentIndex];
+		std::string value = argv[argumentIndex + 1];
+		if (flag == "-i")
+		{
+			options.input = value;
+		}
+		else if (flag == "-o")
+		{
+			options.output = value;
+		}
+		else if (flag == "-f" && (value == "csv" || value == "binary"))
+		{
+			options.binary = value == "binary";
+		}
+		else if (flag == "-b")
+		{
+			options.batchRows = (std::max)(std::stoul(value), 1ul);
+		}
+		else if (flag == "-t")
+		{
+			options.threads = std::stoul(value);
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return true;
+};
+/*
+ * Reads up to batchRows rows into the batch, returns false at the end of the input
+ */
+static const bool readBatch(std::istream &input, const bool &binary, const unsigned long &inputSize, const unsigned long &batchRows, Batch &batch, unsigned long &lineNumber)
+{
+	batch.inputs.resize(batchRows * inputSize);
+	batch.rows = 0;
+	std::vector<double> row(inputSize);
+	std::string line;
+	while (batch.rows < batchRows)
+	{
+		auto values = batch.inputs.data() + batch.rows * inputSize;
+		if (binary)
+		{
+			if (!input.read((char *)row.data(), inputSize * sizeof(double)))
+			{
+				if (input.gcount() != 0)
+				{
+					throw std::runtime_error("Truncated binary row " + std::to_string(lineNumber + 1));
+				}
+				break;
+			}
+			std::copy(row.begin(), row.end(), values);
+			lineNumber++;
+		}
+		else
+		{
+			if (!std::getline(input, line))
+			{
+				break;
+			}
+			lineNumber++;
+			if (!line.empty() && line.back() == '\r')
+			{
+				line.pop_back();
+			}
+			if (line.empty())
+			{
+				throw std::runtime_error("Line " + std::to_string(lineNumber) + " is empty");
+			}
+			const char *cursor = line.c_str();
+			for (unsigned long valueIndex = 0; valueIndex < inputSize; valueIndex++)
+			{
+				char *end;
+				values[valueIndex] = std::strtold(cursor, &end);
+				if (end == cursor || (valueIndex + 1 < inputSize && *end != ','))
+				{
+					throw std::runtime_error("Line " + std::to_string(lineNumber) + " does not have " + std::to_string(inputSize) + " values");
+				}
+				cursor = end + (valueIndex + 1 < inputSize);
+			}
+			// Only whitespace may follow the last value
+			cursor += std::strspn(cursor, " \t");
+			if (*cursor)
+			{
+				throw std::runtime_error("Line " + std::to_string(lineNumber) + " has more than " + std::to_string(inputSize) + " values or trailing characters");
+			}
+		}
+		batch.rows++;
+	}
+	batch.inputs.resize(batch.rows * inputSize);
+	return batch.rows > 0;
+};
+/*
+ */
+static void writeBatch(std::ostream &output, const bool &binary, const unsigned long &outputSize, const Batch &batch)
+{
+	if (binary)
+	{
+		std::vector<double> row(batch.outputs.begin(), batch.outputs.end());
+		output.write((const char *)row.data(), row.size() * sizeof(double));
+		return;
+	}
+	std::ostringstream text;
+	text.precision(std::numeric_limits<double>::max_digits10);
+	for (unsigned long rowIndex = 0; rowIndex < batch.rows; rowIndex++)
+	{
+		for (unsigned long valueIndex = 0; valueIndex < outputSize; valueIndex++)
+		{
+			text << (valueIndex ? "," : "") << (double)batch.outputs[rowIndex * outputSize + valueIndex];
+		}
+		text << '\n';
+	}
+	output << text.str();
+};
+/*
+ */
+static const double percentile(const std::vector<double> &sorted, const double &fraction)
+{
+	if (sorted.empty())
+	{
+		return 0;
+	}
+	return sorted[(unsigned long)(fraction * (sorted.size() - 1) + 0.5)];
+};
+/*
+ */
+int main(int argc, char **argv)
+{
+	Options options;
+	try
+	{
+		if (!parseOptions(argc, argv, options))
+		{
+			std::cerr << "Error: Usage: zeuron-infer <model.nrl> [-i input] [-o output] [-f csv|binary] [-b rows per batch] [-t threads]" << std::endl;
+			return 1;
+		}
+	}
+	catch (const std::exception &)
+	{
+		std::cerr << "Error: Invalid number in the arguments" << std::endl;
+		return 1;
+	}
+	try
+	{
+		auto network = NeuralNetwork::load(options.model);
+		auto inputSize = network->layers.front().neurons.size();
+		auto outputSize = network->layers.back().neurons.size();
+		// Models a PackedNetwork supports are predicted lock free from a packed copy, others through the network's lock
+		std::unique_ptr<PackedNetwork> packed;
+		if (PackedNetwork::supports(*network))
+		{
+			packed = std::make_unique<PackedNetwork>(*network);
+		}
+		std::ifstream inputFile;
+		std::ofstream outputFile;
+		auto mode = options.binary ? std::ios::binary : std::ios::openmode();
+		if (options.input != "-")
+		{
+			inputFile.open(options.input, std::ios::in | mode);
+			if (!inputFile)
+			{
+				throw std::ios_base::failure("Error: Unable to open " + options.input);
+			}
+		}
+		if (options.output != "-")
+		{
+			outputFile.open(options.output, std::ios::out | std::ios::trunc | mode);
+			if (!outputFile)
+			{
+				throw std::ios_base::failure("Error: Unable to open " + options.output);
+			}
+		}
+		std::istream &input = options.input == "-" ? std::cin : inputFile;
+		std::ostream &output = options.output == "-" ? std::cout : outputFile;
+		std::ios::sync_with_stdio(false);
+		// The writer thread counts against the core budget, so the executor is sized around it
+		Executor::CoreReservation writerCore;
+		Executor executor(options.threads);
+		auto inFlightCapacity = 4 * (std::max)(1ul, executor.size());
+		// Batches in input order, the writer waits for each one to be predicted. The predicting task shares the
+		// batch, so the writer may drop it while set_value is still returning
+		BoundedQueue<std::shared_ptr<Batch>> inFlight(inFlightCapacity);
+		std::vector<double> latencies;
+		unsigned long rowsWritten = 0;
+		std::exception_ptr writerError;
+		auto start = std::chrono::steady_clock::now();
+		std::thread writer([&]
+		{
+			std::shared_ptr<Batch> batch;
+			while (inFlight.pop(batch))
+			{
+				try
+				{
+					batch->done.get();
+					latencies.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - batch->submitted).count());
+					if (!writerError)
+					{
+						writeBatch(output, options.binary, outputSize, *batch);
+						rowsWritten += batch->rows;
+					}
+				}
+				catch (...)
+				{
+					if (!writerError)
+					{
+						writerError = std::current_exception();
+					}
+				}
+			}
+		});
+		unsigned long lineNumber = 0;
+		std::exception_ptr readerError;
+		try
+		{
+			while (true)
+			{
+				auto batch = std::make_shared<Batch>();
+				if (!readBatch(input, options.binary, inputSize, options.batchRows, *batch, lineNumber))
+				{
+					break;
+				}
+				batch->submitted = std::chrono::steady_clock::now();
+				batch->done = batch->predicted.get_future();
+				executor.submit([sharedBatch = batch, &packed, &network, inputSize, outputSize]
+				{
+					auto &batch = *sharedBatch;
+					batch.outputs.resize(batch.rows * outputSize);
+					try
+					{
+						if (packed)
+						{
+							thread_local std::vector<long double> scratch;
+							scratch.resize((std::max)(scratch.size(), 2 * packed->maxLayerSize));
+							for (unsigned long rowIndex = 0; rowIndex < batch.rows; rowIndex++)
+							{
+								packed->predict(batch.inputs.data() + rowIndex * inputSize, batch.outputs.data() + rowIndex * outputSize, scratch.data());
+							}
+						}
+						else
+						{
+							for (unsigned long rowIndex = 0; rowIndex < batch.rows; rowIndex++)
+							{
+								auto rowInputs = batch.inputs.begin() + rowIndex * inputSize;
+								auto rowOutputs = network->predict(std::vector<long double>(rowInputs, rowInputs + inputSize));
+								std::copy(rowOutputs.begin(), rowOutputs.end(), batch.outputs.begin() + rowIndex * outputSize);
+							}
+						}
+					}
+					catch (...)
+					{
+						batch.predicted.set_exception(std::current_exception());
+						return;
+					}
+					batch.predicted.set_value();
+				}, Executor::Normal);
+				if (!inFlight.push(std::move(batch)))
+				{
+					break;
+				}
+			}
+		}
+		catch (...)
+		{
+			readerError = std::current_exception();
+		}
+		inFlight.close();
+		writer.join();
+		output.flush();
+		if (readerError)
+		{
+			std::rethrow_exception(readerError);
+		}
+		if (writerError)
+		{
+			std::rethrow_exception(writerError);
+		}
+		if (!output)
+		{
+			throw std::ios_base::failure("Error: Unable to write the outputs");
+		}
+		auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::sort(latencies.begin(), latencies.end());
+		std::ostringstream report;
+		report.precision(3);
+		report << std::fixed << rowsWritten << " rows in " << seconds << " s, " << (seconds > 0 ? rowsWritten / seconds : 0.0)
+			<< " rows/s, " << executor.size() << " threads, batch latency ms p50 " << percentile(latencies, 0.5) * 1e3
+			<< " p90 " << percentile(latencies, 0.9) * 1e3 << " p99 " << percentile(latencies, 0.99) * 1e3
+			<< " max " << (latencies.empty() ? 0.0 : latencies.back() * 1e3);
+		std::cerr << "Info: " << report.str() << std::endl;
+	}
+	catch (const std::exception &exception)
+	{
+		std::cerr << "Error: " << exception.what() << std::endl;
+		return 1;
+	}
+	return 0;
+};
+/*
+ */